@@ -0,0 +1,266 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "distributions.h"
+
+//transcendental heavy distributions with polynomial log, exp and sin/cos in place of libm, for code that needs a few
+//digits rather than full float accuracy, every function is branch free float arithmetic so a loop over a block of
+//uniforms can vectorize, sqrt is left to the hardware instruction which is already exact and vectorizes
+//(gcc only vectorizes the clamp in exp with -fno-trapping-math, and Libm with -fno-math-errno)
+
+namespace approx {
+
+const int BLOCK = 256; //variates per refill, even so normals come in whole pairs
+const float TWO_PI = 6.28318530717958648f;
+const float PI = 3.14159265358979324f;
+
+inline float asFloat(std::uint32_t bits)
+{
+	float x;
+	std::memcpy(&x, &bits, sizeof x);
+	return x;
+}
+
+inline std::uint32_t asBits(float x)
+{
+	std::uint32_t bits;
+	std::memcpy(&bits, &x, sizeof bits);
+	return bits;
+}
+
+//nearest integer, ties away from zero, without a call to round
+inline int nearest(float x)
+{
+	return static_cast<int>(x + (x < 0 ? -0.5f : 0.5f));
+}
+
+//uniform in (0, 1), the midpoints of 2^23 cells, so log and log(-log) stay finite
+template<typename Engine>
+inline float openUniform(Engine& eng)
+{
+	return (static_cast<float>(randomBits(eng, 23)) + 0.5f) * (1.0f / 8388608.0f);
+}
+
+
+//truncated Taylor series after range reduction, Digits 4 keeps the relative error under 1e-4 and 7 near 1e-7,
+//the float rounding floor, the error actually reached is measured by the benchmark rather than promised here
+template<int Digits>
+struct Math
+{
+	static_assert(Digits == 4 || Digits == 7, "approx::Math has 4 and 7 digit polynomials");
+	static const bool HIGH = Digits == 7;
+
+	//x = m * 2^k with m in [sqrt(1/2), sqrt(2)), log(m) = 2 atanh(s) for s = (m - 1) / (m + 1), |s| < 0.172
+	//the odd series stops at s^5 (error 2s^7/7) or s^9 (error 2s^11/11), x must be positive and finite
+	static float log(float x)
+	{
+		std::uint32_t ix = asBits(x) - 0x3F3504F3; //bits of sqrt(1/2)
+		int k = static_cast<std::int32_t>(ix) >> 23;
+		float m = asFloat((ix & 0x007FFFFF) + 0x3F3504F3);
+		float s = (m - 1) / (m + 1);
+		float z = s * s;
+		float p = HIGH ? 1 + z * (1.0f / 3 + z * (1.0f / 5 + z * (1.0f / 7 + z * (1.0f / 9))))
+			: 1 + z * (1.0f / 3 + z * (1.0f / 5));
+		return k * 0.693147180559945309f + 2 * s * p;
+	}
+
+	//x = n ln2 + r with |r| <= ln2 / 2 and ln2 split in two so n ln2 is exact, the series stops at r^5 or r^7,
+	//2^n goes straight into the exponent bits, x is clamped to the normal range of float
+	static float exp(float x)
+	{
+		x = (std::min)((std::max)(x, -87.0f), 88.0f);
+		int n = nearest(x * 1.44269504088896341f);
+		float r = x - n * 0.693145751953125f - n * 1.42860682030941723e-6f;
+		float p = HIGH ? 1 + r * (1 + r * (1.0f / 2 + r * (1.0f / 6 + r * (1.0f / 24 + r * (1.0f / 120 + r * (1.0f / 720 + r * (1.0f / 5040)))))))
+			: 1 + r * (1 + r * (1.0f / 2 + r * (1.0f / 6 + r * (1.0f / 24 + r * (1.0f / 120)))));
+		return p * asFloat(static_cast<std::uint32_t>(n + 127) << 23);
+	}
+
+	//x = k pi/2 + r with |r| <= pi/4 and pi/2 in three parts (Cody and Waite), sin(r) stops at r^5 or r^9 and
+	//cos(r) at r^6 or r^10, the quadrant k & 3 swaps and negates them, meant for |x| up to a few thousand
+	static void sincos(float x, float& sine, float& cosine)
+	{
+		int k = nearest(x * 0.636619772367581343f);
+		float r = x - k * 1.5703125f - k * 4.837512969970703125e-4f - k * 7.54978995489188216e-8f;
+		float z = r * r;
+		float s = HIGH ? r * (1 + z * (-1.0f / 6 + z * (1.0f / 120 + z * (-1.0f / 5040 + z * (1.0f / 362880)))))
+			: r * (1 + z * (-1.0f / 6 + z * (1.0f / 120)));
+		float c = HIGH ? 1 + z * (-1.0f / 2 + z * (1.0f / 24 + z * (-1.0f / 720 + z * (1.0f / 40320 + z * (-1.0f / 3628800)))))
+			: 1 + z * (-1.0f / 2 + z * (1.0f / 24 + z * (-1.0f / 720)));
+		float sk = k & 1 ? c : s;
+		float ck = k & 1 ? s : c;
+		sine = k & 2 ? -sk : sk;
+		cosine = (k + 1) & 2 ? -ck : ck;
+	}
+
+	static float sqrt(float x) { return std::sqrt(x); }
+};
+
+//the float functions of libm, what the approximations are timed against
+struct Libm
+{
+	static float log(float x) { return std::log(x); }
+	static float exp(float x) { return std::exp(x); }
+	static void sincos(float x, float& sine, float& cosine)
+	{
+		sine = std::sin(x);
+		cosine = std::cos(x);
+	}
+	static float sqrt(float x) { return std::sqrt(x); }
+};
+
+//double libm rounded to float, the reference the errors of the others are measured against
+struct Reference
+{
+	static float log(float x) { return static_cast<float>(std::log(static_cast<double>(x))); }
+	static float exp(float x) { return static_cast<float>(std::exp(static_cast<double>(x))); }
+	static void sincos(float x, float& sine, float& cosine)
+	{
+		sine = static_cast<float>(std::sin(static_cast<double>(x)));
+		cosine = static_cast<float>(std::cos(static_cast<double>(x)));
+	}
+	static float sqrt(float x) { return static_cast<float>(std::sqrt(static_cast<double>(x))); }
+};
+
+
+//transforms of a block of uniforms in (0, 1), one per distribution, the same arithmetic for every Math
+
+//Box-Muller, each pair of uniforms gives a pair of normals
+struct Normal
+{
+	float mean;
+	float stddev;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		for (int i = 0; i < n; i += 2)
+		{
+			float r = stddev * M::sqrt(-2 * M::log(u[i]));
+			float s, c;
+			M::sincos(TWO_PI * u[i + 1], s, c);
+			out[i] = mean + r * c;
+			out[i + 1] = mean + r * s;
+		}
+	}
+};
+
+//exp of a Box-Muller normal(m, s)
+struct Lognormal
+{
+	float m;
+	float s;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		Normal{ m, s }.apply<M>(u, out, n);
+		for (int i = 0; i < n; i++)
+			out[i] = M::exp(out[i]);
+	}
+};
+
+//b (-log u)^(1 / a)
+struct Weibull
+{
+	float a;
+	float b;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		const float inv = 1 / a;
+		for (int i = 0; i < n; i++)
+			out[i] = b * M::exp(inv * M::log(-M::log(u[i])));
+	}
+};
+
+//a - b log(-log u), the gumbel of std::extreme_value_distribution
+struct ExtremeValue
+{
+	float a;
+	float b;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		for (int i = 0; i < n; i++)
+			out[i] = a - b * M::log(-M::log(u[i]));
+	}
+};
+
+//a + b tan(pi (u - 1/2)), tan as sin / cos
+struct Cauchy
+{
+	float a;
+	float b;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		for (int i = 0; i < n; i++)
+		{
+			float s, c;
+			M::sincos(PI * (u[i] - 0.5f), s, c);
+			out[i] = a + b * s / c;
+		}
+	}
+};
+
+//-log(u) / lambda
+struct Exponential
+{
+	float lambda;
+
+	template<typename M>
+	void apply(const float* u, float* out, int n) const
+	{
+		const float inv = -1 / lambda;
+		for (int i = 0; i < n; i++)
+			out[i] = inv * M::log(u[i]);
+	}
+};
+
+}
+
+
+//block sampler, a block of uniforms is drawn from the engine then turned into variates by Transform in one loop
+//with the functions of Math, the uniforms consumed do not depend on Math, so two instances with different Math
+//fed copies of one engine give the same variates up to the error of their functions
+template<typename Transform, typename Math = approx::Math<7>>
+class ApproxDistribution
+{
+public:
+	typedef float result_type;
+
+	explicit ApproxDistribution(const Transform& transform) : _transform(transform), _next(approx::BLOCK) {}
+
+	//drop any values left in the block
+	void reset() { _next = approx::BLOCK; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (_next == approx::BLOCK)
+			refill(eng);
+		return _block[_next++];
+	}
+
+private:
+	template<typename Engine>
+	void refill(Engine& eng)
+	{
+		for (int j = 0; j < approx::BLOCK; j++)
+			_uniforms[j] = approx::openUniform(eng);
+		_transform.template apply<Math>(_uniforms, _block, approx::BLOCK);
+		_next = 0;
+	}
+
+	Transform _transform;
+	int _next;
+	float _uniforms[approx::BLOCK];
+	float _block[approx::BLOCK];
+
+};
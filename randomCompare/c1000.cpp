@@ -1,19 +1,46 @@
 #include <algorithm>
 #include <cctype>
 #include <fstream>
+#include <limits>
+#include <cstdlib>
 #include <memory>
+#include <new>
+#include <numeric>
+#include <thread>
 #include "engines.h"
 
 //settings struct, default initialized to...defaults
 struct Settings {
 	std::string progN = "";
 	std::string fileN = "";
-	int level = 3; //level 1 = run engine(), level 2 = run dist1-3(eng), level 3 = run dist1-3(eng) assigned to vector
+	std::string scenarioN = ""; //workload file, read as scenarioN.ini
+	int level = 3; //level 1 = run engine(), level 2 = run each dist(eng), level 3 = run each dist(eng) assigned to vector
 	int iterations = 1000000; // 1 - 5,000,000
 	int clock = 2;
 	bool help = false;
 	bool pagination = true;
 	bool sorting = true;
+	bool interleave = false;
+	bool sweep = false;
+	bool discrete = false;
+	bool geometry = false;
+	bool shuffle = false;
+	bool approximate = false;
+	bool matrix = false;
+	bool perCall = false;
+	int isa = simd::detectIsa(); //highest SIMD instruction set kernels may use
+	int minTime = 0; //milliseconds each test is grown to, 0 = fixed iterations
+	int repetitions = 1; // 1 - 100
+	int order = 0; //0 = each test's repetitions back to back, 1 = round robin passes, 2 = round robin passes in shuffled order
+	unsigned int orderSeed = std::random_device()();
+	bool isolate = false;
+	bool resources = false;
+	bool traced = false;
+	int stressors = 0; //stressor threads of the interference test, 0 - 16
+	int outputSink = 0; //level 3 memory, 0 = std::vector, see sink::kinds
+	int cold = 0; //0 = off, 1 = clflush the state before each call, 2 = sweep a buffer larger than the cache before each call
+	int child = -1; //test to run as a child process of an isolated run, -1 = not a child
+	std::vector<Scenario> scenarios;
 
 };
 
@@ -22,6 +49,57 @@ static Settings set;
 int& BaseTest::level(set.level);
 int& BaseTest::iterations(set.iterations);
 int& BaseTest::clock(set.clock);
+bool& BaseTest::interleave(set.interleave);
+bool& BaseTest::sweep(set.sweep);
+bool& BaseTest::discrete(set.discrete);
+bool& BaseTest::geometry(set.geometry);
+bool& BaseTest::shuffle(set.shuffle);
+bool& BaseTest::approximate(set.approximate);
+bool& BaseTest::matrix(set.matrix);
+bool& BaseTest::perCall(set.perCall);
+int& BaseTest::isa(set.isa);
+int& BaseTest::minTime(set.minTime);
+int& BaseTest::repetitions(set.repetitions);
+int& BaseTest::order(set.order);
+unsigned int& BaseTest::orderSeed(set.orderSeed);
+bool& BaseTest::isolate(set.isolate);
+bool& BaseTest::resources(set.resources);
+int& BaseTest::cold(set.cold);
+bool& BaseTest::traced(set.traced);
+int& BaseTest::stressors(set.stressors);
+int& BaseTest::outputSink(set.outputSink);
+std::vector<Scenario>& BaseTest::scenarios(set.scenarios);
+
+
+//every allocation of the program goes through here so the usage rows can count them, new[] and the sized and
+//array deletes forward to these, the aligned operator new is left alone and its allocations are not counted
+//counted only with -v so that otherwise an allocation costs what malloc costs
+void* operator new(std::size_t size)
+{
+	if (usage::counting())
+		usage::countAllocation(size);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+//gcc takes the free of a pointer from operator new as a mismatch even when operator new is this malloc
+#if defined(__GNUC__) && __GNUC__ >= 11 && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+#if defined(__GNUC__) && __GNUC__ >= 11 && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 
 enum errors {
@@ -29,7 +107,10 @@ enum errors {
 	IMPROPER_USAGE,
 	ILLEGAL_VALUE,
 	OUT_OF_BOUNDS_VALUE,
-	ILLEGAL_FILENAME
+	ILLEGAL_FILENAME,
+	UNSUPPORTED_ISA,
+	BAD_SCENARIO,
+	NO_SPARE_CPU
 
 };
 
@@ -43,34 +124,167 @@ void printHelp()
 		<< " -h\t|\n"
 		<< "\t| @Display help message\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -a\t|   0\tScalar\n"
+		<< "\t|   1\tSSE2\n"
+		<< "\t|   2\tSSE4.1\n"
+		<< "\t|   3\tAVX2\n"
+		<< "\t|   4\tAVX-512\n"
+		<< "\t| @Highest instruction set for SIMD kernels\n"
+		<< "\t| @Level 1 times SIMD engines for each set up to it\n"
+		<< "\t| @default: " << simd::isaName(simd::detectIsa()) << " (detected)\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -b\t|   0\tDisable\n"
+		<< "\t|   1\tFlush engine and distribution state (clflush)\n"
+		<< "\t|   2\tSweep a 64MB buffer, also evicts tables\n"
+		<< "\t| @Also time single calls with a cold cache against\n"
+		<< "\t| @the same calls with a warm one\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -c\t|   1\tFastest, Slowest, Mean, Total\n"
 		<< "\t|   2\tTotal, CPU\n"
 		<< "\t| @(1)Time each call or (2)time overall\n"
 		<< "\t| @default: Real Clock + CPU time\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -d\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also time discrete tables of 8 - 1M weights\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -e\t|   1-100\t\n"
+		<< "\t| @Run each test this many times, keeping the fastest\n"
+		<< "\t| @run of each distribution\n"
+		<< "\t| @default: 1\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -f\t|   FILENAME\t\n"
 		<< "\t| @Print results to FILENAME.txt\n"
 		<< "\t| @default: print to console\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -g\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also time circle, sphere, disc, cone, triangle samplers\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -i\t|   1-10000000\t\n"
 		<< "\t| @Set number of iterations per test\n"
 		<< "\t| @default: 1,000,000\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -j\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Run each test, or each repetition with -e, in a\n"
+		<< "\t| @child process of its own pinned to one cpu\n"
+		<< "\t| @(not pinned with -y, which pins its own threads)\n"
+		<< "\t| @A crashing engine only loses its own results\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -k\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also run K = 1, 2, 4, 8 interleaved engine instances\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -l\t|   1\tPRNG wo distribution\n"
-		<< "\t|   2\tPRNG w 3 distributions\n"
-		<< "\t|   3\tPRNG w 3 distributions, assign to vec\n"
+		<< "\t|   2\tPRNG w distributions\n"
+		<< "\t|   3\tPRNG w distributions, assign to vec\n"
 		<< "\t| @Set benchmark level\n"
 		<< "\t| @default: 3\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -m\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also time polynomial log/exp/sin/cos distributions\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -n\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also time a fresh param_type on every call\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -o\t|   0\tFixed, repetitions back to back\n"
+		<< "\t|   1\tRound robin, one pass over all tests per repetition\n"
+		<< "\t|   2\tRound robin, each pass in a new shuffled order\n"
+		<< "\t| @Order tests run in, 2 also estimates the bias of\n"
+		<< "\t| @running early or late in a pass (needs -e 2+)\n"
+		<< "\t| @-o 2 <seed> repeats the orders of the run that\n"
+		<< "\t| @printed that seed\n"
+		<< "\t| @default: 0\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -p\t|   0\tDisable\n"
 		<< "\t|   1\tEnable\n"
 		<< "\t| @Enable/Disable pagination when printing to console\n"
 		<< "\t| @default: enabled\n"
 		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -q\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also trace the latency of every call and report\n"
+		<< "\t| @the period, size and time share of slow calls\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -r\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also sweep poisson/binomial means and gamma family shapes\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
 		<< " -s\t|   0\tDisable\n"
 		<< "\t|   1\tEnable\n"
 		<< "\t| @Enable/Disable sorting of results\n"
-		<< "\t| @default: enabled\n";
+		<< "\t| @default: enabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -S\t|   0\tstd::vector, bools as bits\n"
+		<< "\t|   1\tstd::vector, bools as bytes\n"
+		<< "\t|   2\tPrefaulted pages\n"
+		<< "\t|   3\tFirst touch, page faults while timing\n"
+		<< "\t|   4\tStreaming (non-temporal) stores\n"
+		<< "\t|   5\tHuge pages\n"
+		<< "\t|   6\t16KB ring that stays in L1\n"
+		<< "\t| @Where level 3 writes its values, 2-6 store bools\n"
+		<< "\t| @as bytes\n"
+		<< "\t| @default: 0\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -t\t|   1-60000\t\n"
+		<< "\t| @Double the iterations of each test, starting from -i,\n"
+		<< "\t| @until it runs for at least this many milliseconds\n"
+		<< "\t| @Reports iterations used and ns per call\n"
+		<< "\t| @default: off, every test runs -i iterations\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -u\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also time shuffles of 52 - 100M elements and k-of-n samples\n"
+		<< "\t| @The 100M shuffles run only with -i 1000000+, they\n"
+		<< "\t| @take 400MB and minutes per engine\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -v\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Report page faults, context switches, peak RSS and\n"
+		<< "\t| @heap allocations of every row, rows preempted by\n"
+		<< "\t| @the scheduler are marked noisy\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -w\t|   FILENAME\t\n"
+		<< "\t| @Also run the scenarios of FILENAME.ini on each engine\n"
+		<< "\t| @One [section] per scenario, one step per key:\n"
+		<< "\t| @name = kind weight parameters, kinds are\n"
+		<< "\t| @uniform_int a b, uniform_real a b, normal m s,\n"
+		<< "\t| @bernoulli p, exponential l, poisson m, discrete w...\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: none\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -x\t|   0\tDisable\n"
+		<< "\t|   1\tEnable\n"
+		<< "\t| @Also sweep range sizes and types into an engine matrix\n"
+		<< "\t| @Level 2 and 3 only\n"
+		<< "\t| @default: disabled\n"
+		<< std::setfill('-') << std::setw(55) << "" << '\n'
+		<< " -y\t|   0-16\t\n"
+		<< "\t| @Also time calls while this many threads on cpus\n"
+		<< "\t| @1, 2, ... thrash the cache, stream memory or run\n"
+		<< "\t| @branch heavy code, measured on cpu 0\n"
+		<< "\t| @Needs 2+ cpus\n"
+		<< "\t| @default: 0, disabled\n";
 	
 
 }
@@ -93,6 +307,16 @@ void printError(errors err)
 		break;
 	case ILLEGAL_FILENAME:
 		std::cerr << ">Error: Missing or illegal filename";
+		break;
+	case UNSUPPORTED_ISA:
+		std::cerr << ">Error: Instruction set not supported by this CPU (highest: " << simd::isaName(simd::detectIsa()) << ")";
+		break;
+	case BAD_SCENARIO:
+		std::cerr << ">Error: Unusable scenario file";
+		break;
+	case NO_SPARE_CPU:
+		std::cerr << ">Error: Stressors need a cpu besides the measured one (found " << std::thread::hardware_concurrency() << ")";
+		break;
 	default:
 		break;
 	}
@@ -148,6 +372,79 @@ bool parseOptions(const std::vector<std::string>& args)
 					return false;
 				}
 			}
+			else if (args[i][1] == 't') //minimum time switch, argument must be number, must be between 1 and 60,000 inclusive
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 6) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp < 60001 && temp > 0)
+					{
+						set.minTime = temp;
+						i++;
+					}
+					else // value too large or too small
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'e') //repetitions switch, argument must be number, must be between 1 and 100 inclusive
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 4) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp < 101 && temp > 0)
+					{
+						set.repetitions = temp;
+						i++;
+					}
+					else // value too large or too small
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'o') // order switch, argument must be number, must be 1 digit, 2 may be followed by a seed
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1 || temp == 2)
+					{
+						set.order = temp;
+						i++;
+						if (temp == 2 && i + 1 < args.size() && isNumber(args[i + 1]))
+						{ //the seed of an earlier run, to shuffle the same orders again
+							if (args[i + 1].size() > 10 || std::stoull(args[i + 1]) > std::numeric_limits<unsigned int>::max())
+							{
+								printError(errors::OUT_OF_BOUNDS_VALUE);
+								return false;
+							}
+							set.orderSeed = static_cast<unsigned int>(std::stoull(args[i + 1]));
+							i++;
+						}
+					}
+					else //value not 0,1,2
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
 			else if (args[i][1] == 'l') //test level switch, argument must be number, must be 1 digit
 			{
 				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i+1].size() < 2) {
@@ -182,6 +479,19 @@ bool parseOptions(const std::vector<std::string>& args)
 					return false;
 				}
 			}
+			else if (args[i][1] == 'w') // scenario file switch, argument must be valid filename
+			{
+				if (i + 1 < args.size() && isValidFN(args[i + 1]))
+				{
+					set.scenarioN = args[i + 1];
+					i++;
+				}
+				else // bad filename
+				{
+					printError(errors::ILLEGAL_FILENAME);
+					return false;
+				}
+			}
 			else if (args[i][1] == 'c') // clock switch, argument must be number, must be 1 digit
 			{
 				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
@@ -245,6 +555,341 @@ bool parseOptions(const std::vector<std::string>& args)
 					return false;
 				}
 			}
+			else if (args[i][1] == 'a') // instruction set switch, argument must be number, must be 1 digit, must be supported
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp >= simd::ISA_COUNT)
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+					else if (temp > simd::detectIsa()) //forcing an unsupported set would fault on the first kernel
+					{
+						printError(errors::UNSUPPORTED_ISA);
+						return false;
+					}
+					set.isa = temp;
+					i++;
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'k') // interleave switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.interleave = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'd') // discrete table switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.discrete = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'g') // geometry switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.geometry = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'u') // shuffle switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.shuffle = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'm') // approximate math switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.approximate = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'x') // sweep matrix switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.matrix = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'n') // per-call param switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.perCall = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'j') // isolation switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.isolate = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'v') // resource usage switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.resources = temp;
+						usage::counting() = set.resources;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'b') // cache cold switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1 || temp == 2)
+					{
+						set.cold = temp;
+						i++;
+					}
+					else //value not 0,1,2
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'q') // latency trace switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.traced = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'y') //stressor switch, argument must be number, must be between 0 and 16 inclusive
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 3) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp > 0 && std::thread::hardware_concurrency() < 2)
+					{ //on one cpu the stressors would only time-slice with the measured thread
+						printError(errors::NO_SPARE_CPU);
+						return false;
+					}
+					else if (temp < 17 && temp >= 0)
+					{
+						set.stressors = temp;
+						i++;
+					}
+					else // value too large
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'S') // output sink switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp < sink::KIND_COUNT)
+					{
+						set.outputSink = temp;
+						i++;
+					}
+					else //value not 0-6
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'z') // hidden child switch added by an isolated parent, argument must be a test number
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 4) {
+					set.child = std::stoi(args[i + 1]);
+					i++;
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
+			else if (args[i][1] == 'r') // parameter sweep switch, argument must be number, must be 1 digit
+			{
+				if (i + 1 < args.size() && isNumber(args[i + 1]) && args[i + 1].size() < 2) {
+					int temp = std::stoi(args[i + 1]);
+					if (temp == 0 || temp == 1)
+					{
+						set.sweep = temp;
+						i++;
+					}
+					else //value not 0,1
+					{
+						printError(errors::OUT_OF_BOUNDS_VALUE);
+						return false;
+					}
+				}
+				else  // not a sane number, or no argument
+				{
+					printError(errors::ILLEGAL_VALUE);
+					return false;
+				}
+			}
 			else // bad or unrecognized flag
 			{
 				printError(errors::ILLEGAL_FLAG);
@@ -300,6 +945,19 @@ int main(int argc, char* argv[])
 	}
 
 
+	//read the workload file before any engine runs, so a bad file fails fast
+	if (!set.scenarioN.empty())
+	{
+		std::string error;
+		if (!loadScenarios(set.scenarioN + ".ini", set.scenarios, error))
+		{
+			std::cerr << ">" << error << '\n';
+			printError(errors::BAD_SCENARIO);
+			return EXIT_FAILURE;
+		}
+	}
+
+
 	//Create std random EngineTest pointers
 	std::unique_ptr<BaseTest> t0(new EngineTest<std::minstd_rand>("std - Minimum Standard"));
 	std::unique_ptr<BaseTest> t1(new EngineTest<std::minstd_rand0>("std - Minimum Standard 0"));
@@ -409,9 +1067,54 @@ int main(int argc, char* argv[])
 //	tests.push_back(std::move(t40));
 	tests.push_back(std::move(t41));
 
-	//run each instances test
-	for (int i = 0; i < tests.size(); i++)
-		tests[i]->operator()();
+	//as a child run the one test the parent asked for and hand its rows back after the marker
+	if (set.child >= 0)
+	{
+		if (set.child >= tests.size())
+		{
+			printError(errors::OUT_OF_BOUNDS_VALUE);
+			return EXIT_FAILURE;
+		}
+		//the interference test pins its own threads to cpus 0, 1, ..., which a process pinned to one cpu would not allow
+		if (!set.stressors)
+			isolation::pinProcess(isolation::childCpu());
+		tests[set.child]->operator()();
+		std::cout << isolation::MARKER << '\n';
+		tests[set.child]->save(std::cout);
+		return EXIT_SUCCESS;
+	}
+
+	//when isolated every run is this program again with the same options and the test to run
+	std::string command = "";
+	if (set.isolate)
+	{
+		command = '"' + args[0] + '"';
+		for (int i = 1; i < args.size(); i++)
+			command += ' ' + args[i];
+		command += " -z ";
+	}
+	auto child = [&](std::size_t i) { return command.empty() ? command : command + std::to_string(i); };
+
+	//run each instances test, repetitions either back to back or as passes over every test
+	if (set.order == 0)
+	{
+		for (int i = 0; i < tests.size(); i++)
+			for (int r = 0; r < set.repetitions; r++)
+				tests[i]->runAt(i, child(i));
+	}
+	else
+	{
+		std::vector<std::size_t> order(tests.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::mt19937 shuffler(set.orderSeed);
+		for (int r = 0; r < set.repetitions; r++)
+		{
+			if (set.order == 2)
+				std::shuffle(order.begin(), order.end(), shuffler);
+			for (int i = 0; i < order.size(); i++)
+				tests[order[i]]->runAt(i, child(order[i]));
+		}
+	}
 
 	//If sorting enabled, sort vector
 	if (set.sorting)
@@ -421,6 +1124,8 @@ int main(int argc, char* argv[])
 			std::sort(tests.begin(), tests.end(), simpleTotalSort());
 		else
 			std::sort(tests.begin(), tests.end(), multiTotalSort());
+		//tests whose every child failed have nothing to rank
+		std::stable_partition(tests.begin(), tests.end(), [](const std::unique_ptr<BaseTest>& t) { return !t->getRuns().empty(); });
 		std::cout << "done!\n";
 	}
 
@@ -436,6 +1141,8 @@ int main(int argc, char* argv[])
 				std::cin.ignore();
 			}
 		}
+		std::cout << formatMatrix(tests);
+		std::cout << formatOrderBias(tests);
 		std::cout << EngineTest<>::getSettings();
 	}
 	//else print to file
@@ -446,6 +1153,8 @@ int main(int argc, char* argv[])
 		results.open(set.fileN);
 		for (int i = 0; i < tests.size(); i++)
 			results << tests[i]->getResults();
+		results << formatMatrix(tests);
+		results << formatOrderBias(tests);
 		results << EngineTest<>::getSettings();
 		results.close();
 	}
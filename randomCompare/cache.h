@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "simd.h"
+
+//pushing the state of an engine or distribution out of the cache, so a call can be timed as it runs after the rest of
+//a frame has walked over memory, either the lines of the objects are flushed with clflush, or a buffer larger than
+//the last level cache is swept, which also evicts tables the objects only point to, targets without clflush sweep
+
+namespace cache {
+
+const std::size_t LINE = 64;
+const std::size_t SWEEP_BYTES = 64 << 20; //larger than the last level cache of most desktop and server parts
+const int FLUSH_CALLS = 1000; //calls timed per row, a sweep costs milliseconds so it gets fewer
+const int SWEEP_CALLS = 64;
+
+//memory a call reads or writes
+struct Region
+{
+	const void* p;
+	std::size_t bytes;
+
+};
+
+template<typename O>
+inline Region region(const O& o)
+{
+	return Region{ &o, sizeof o };
+}
+
+#if SIMD_X86
+//write back and invalidate every line of r in every cache level
+SIMD_TARGET("sse2")
+inline void flush(const Region& r)
+{
+	std::uintptr_t first = reinterpret_cast<std::uintptr_t>(r.p) & ~(LINE - 1);
+	std::uintptr_t last = reinterpret_cast<std::uintptr_t>(r.p) + r.bytes;
+	for (std::uintptr_t line = first; line < last; line += LINE)
+		_mm_clflush(reinterpret_cast<const void*>(line));
+}
+
+//the flushes are complete once this returns
+SIMD_TARGET("sse2")
+inline void fence()
+{
+	_mm_mfence();
+}
+#endif
+
+
+class Evictor
+{
+public:
+	explicit Evictor(bool sweep) : _sweep(sweep || !SIMD_X86), _buffer(_sweep ? SWEEP_BYTES : 0) {}
+
+	bool sweeps() const { return _sweep; }
+
+	//evict regions, or everything with a sweep
+	void operator()(const std::vector<Region>& regions)
+	{
+		if (_sweep)
+		{ //one write per line, so every line of the buffer is brought in and whatever held its set is pushed out
+			for (std::size_t i = 0; i < _buffer.size(); i += LINE)
+				_buffer[i]++;
+			return;
+		}
+#if SIMD_X86
+		for (const Region& r : regions)
+			flush(r);
+		fence();
+#endif
+	}
+
+private:
+	bool _sweep;
+	std::vector<unsigned char> _buffer;
+
+};
+
+}
@@ -0,0 +1,782 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+//uniform bits taken from a single engine call
+//power of two ranges give all of theirs, other ranges give 3 bits less than floor(log2(max - min + 1))
+//so that the values rejected in randomBits stay under 1 in 8
+template<typename Engine>
+inline int engineBits()
+{
+	std::uint64_t span = static_cast<std::uint64_t>((Engine::max)()) - static_cast<std::uint64_t>((Engine::min)());
+	if (span == std::numeric_limits<std::uint64_t>::max())
+		return 64;
+	int bits = 0;
+	while ((span + 1) >> (bits + 1))
+		bits++;
+	if (span + 1 == std::uint64_t(1) << bits)
+		return bits;
+	return bits > 3 ? bits - 3 : 1;
+}
+
+//draw count uniform bits from any engine, returned in the low bits
+//the bits are spread evenly over as few calls as possible, each call keeps the low bits of values
+//below the largest multiple of its chunk size so the chunk is exact, which never rejects for power of two ranges
+template<typename Engine>
+inline std::uint64_t randomBits(Engine& eng, int count)
+{
+	const std::uint64_t mask = count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+	const std::uint64_t min = static_cast<std::uint64_t>((Engine::min)());
+	const std::uint64_t span = static_cast<std::uint64_t>((Engine::max)()) - min;
+	const int available = engineBits<Engine>();
+	if (available >= 64)
+		return (static_cast<std::uint64_t>(eng()) - min) & mask;
+	const int calls = (count + available - 1) / available;
+	const int bits = (count + calls - 1) / calls;
+	const std::uint64_t chunk = std::uint64_t(1) << bits;
+	const std::uint64_t limit = (span + 1) / chunk * chunk;
+	std::uint64_t result = 0;
+	for (int c = 0; c < calls; c++)
+	{
+		std::uint64_t u;
+		do
+			u = static_cast<std::uint64_t>(eng()) - min;
+		while (u >= limit);
+		result = (result << bits) | (u & (chunk - 1));
+	}
+	return result & mask;
+}
+
+//draw a uniform Word from any engine
+template<typename Word, typename Engine>
+inline Word uniformBits(Engine& eng)
+{
+	return static_cast<Word>(randomBits(eng, std::numeric_limits<Word>::digits));
+}
+
+//full 64 x 64 -> 128 bit product, returns the low half and stores the high half
+inline std::uint64_t mul128(std::uint64_t a, std::uint64_t b, std::uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+	*high = static_cast<std::uint64_t>(p >> 64);
+	return static_cast<std::uint64_t>(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, high);
+#else
+	//schoolbook on 32 bit halves for 32 bit targets
+	std::uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+	std::uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+	std::uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+	std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+	*high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+
+//bounded integer in [a, b] with Lemire's nearly divisionless multiply shift rejection
+//a random word x maps to (x * s) >> w, the rare low products below 2^w mod s are redrawn so the result stays exact
+//the modulo is only computed on that rare path, ranges up to 2^32 use 32 bit or narrower words so 32 bit engines are called once
+template<typename IntType = int>
+class LemireIntDistribution
+{
+public:
+	typedef IntType result_type;
+	typedef typename std::make_unsigned<IntType>::type range_type;
+
+	class param_type
+	{
+	public:
+		typedef LemireIntDistribution distribution_type;
+		explicit param_type(IntType a = 0, IntType b = (std::numeric_limits<IntType>::max)()) : _a(a), _b(b) {}
+		IntType a() const { return _a; }
+		IntType b() const { return _b; }
+		bool operator==(const param_type& p) const { return _a == p._a && _b == p._b; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		IntType _a;
+		IntType _b;
+	};
+
+	explicit LemireIntDistribution(IntType a = 0, IntType b = (std::numeric_limits<IntType>::max)()) : _param(a, b) {}
+	explicit LemireIntDistribution(const param_type& p) : _param(p) {}
+
+	void reset() {}
+	const param_type& param() const { return _param; }
+	void param(const param_type& p) { _param = p; }
+	IntType a() const { return _param.a(); }
+	IntType b() const { return _param.b(); }
+	result_type min() const { return _param.a(); }
+	result_type max() const { return _param.b(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng) { return (*this)(eng, _param); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		//number of values minus one, so the full range does not overflow
+		std::uint64_t span = static_cast<range_type>(static_cast<range_type>(p.b()) - static_cast<range_type>(p.a()));
+		if (span <= 0xFFFFFFFF)
+			return static_cast<IntType>(static_cast<range_type>(p.a()) + static_cast<range_type>(bounded32(eng, static_cast<std::uint32_t>(span))));
+		return static_cast<IntType>(static_cast<range_type>(p.a()) + static_cast<range_type>(bounded64(eng, span)));
+	}
+
+	//uniform in [0, span] from words of up to 32 bits
+	//small ranges use words as wide as a single engine call, so narrow engines are still only called once
+	template<typename Engine>
+	static std::uint32_t bounded32(Engine& eng, std::uint32_t span)
+	{
+		int bits = engineBits<Engine>() < 32 ? engineBits<Engine>() : 32;
+		if (bits < 32 && span >> bits)
+			bits = 32;
+		if (span == 0xFFFFFFFF)
+			return static_cast<std::uint32_t>(randomBits(eng, 32));
+		const std::uint64_t s = static_cast<std::uint64_t>(span) + 1;
+		const std::uint64_t low = (std::uint64_t(1) << bits) - 1;
+		std::uint64_t m = randomBits(eng, bits) * s;
+		if ((m & low) < s)
+		{
+			std::uint64_t t = (low + 1 - s) % s; //2^bits mod s
+			while ((m & low) < t)
+				m = randomBits(eng, bits) * s;
+		}
+		return static_cast<std::uint32_t>(m >> bits);
+	}
+
+	//uniform in [0, span] from 64 bit words
+	template<typename Engine>
+	static std::uint64_t bounded64(Engine& eng, std::uint64_t span)
+	{
+		if (span == 0xFFFFFFFFFFFFFFFF)
+			return uniformBits<std::uint64_t>(eng);
+		std::uint64_t s = span + 1;
+		std::uint64_t high;
+		std::uint64_t l = mul128(uniformBits<std::uint64_t>(eng), s, &high);
+		if (l < s)
+		{
+			std::uint64_t t = (0 - s) % s; //2^64 mod s
+			while (l < t)
+				l = mul128(uniformBits<std::uint64_t>(eng), s, &high);
+		}
+		return high;
+	}
+
+private:
+	param_type _param;
+
+};
+
+
+//bounded integer in [a, b] that carves a batch of values out of each 64 bit word (Lemire and Brackett's batched ranged integers)
+//with s = b - a + 1 and k values per word, x * s repeated k times gives the values in the high halves and a remainder in the low half
+//the batch is redrawn when the final remainder is below 2^64 mod s^k, which keeps every value exact
+//k is the largest count with s^k <= 2^48, so a rejection happens less than once in 2^16 words, ranges must be narrower than 2^64
+template<typename IntType = int>
+class BitPoolIntDistribution
+{
+public:
+	typedef IntType result_type;
+	typedef typename LemireIntDistribution<IntType>::param_type param_type;
+	typedef typename std::make_unsigned<IntType>::type range_type;
+
+	explicit BitPoolIntDistribution(IntType a = 0, IntType b = 9) { param(param_type(a, b)); }
+	explicit BitPoolIntDistribution(const param_type& p) { param(p); }
+
+	//drop any values left in the pool
+	void reset() { _next = _batch; }
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		_s = static_cast<std::uint64_t>(static_cast<range_type>(static_cast<range_type>(p.b()) - static_cast<range_type>(p.a()))) + 1;
+		std::uint64_t product = 1;
+		_batch = 0;
+		while (_batch < POOL_SIZE && _s <= (std::uint64_t(1) << 48) / product)
+		{
+			product *= _s;
+			_batch++;
+		}
+		if (_batch == 0)
+		{ //ranges above 2^48 get one value per word
+			product = _s;
+			_batch = 1;
+		}
+		_threshold = (0 - product) % product; //2^64 mod s^k
+		reset();
+	}
+	IntType a() const { return _param.a(); }
+	IntType b() const { return _param.b(); }
+	result_type min() const { return _param.a(); }
+	result_type max() const { return _param.b(); }
+
+	//values carved from each engine word
+	int batch() const { return _batch; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (_next == _batch)
+			refill(eng);
+		return static_cast<IntType>(static_cast<range_type>(_param.a()) + static_cast<range_type>(_pool[_next++]));
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	static const int POOL_SIZE = 48; //s = 2 gives 48 values per word
+
+	template<typename Engine>
+	void refill(Engine& eng)
+	{
+		std::uint64_t x;
+		do
+		{
+			x = uniformBits<std::uint64_t>(eng);
+			for (int i = 0; i < _batch; i++)
+				x = mul128(x, _s, &_pool[i]);
+		} while (x < _threshold);
+		_next = 0;
+	}
+
+	param_type _param;
+	std::uint64_t _s;
+	std::uint64_t _threshold;
+	int _batch;
+	int _next;
+	std::uint64_t _pool[POOL_SIZE];
+
+};
+
+
+//forwards to an engine and counts the calls made through it
+template<typename Engine>
+class CountingEngine
+{
+public:
+	typedef typename Engine::result_type result_type;
+
+	explicit CountingEngine(Engine& eng) : _eng(eng), _calls(0) {}
+
+	static constexpr result_type min() { return (Engine::min)(); }
+	static constexpr result_type max() { return (Engine::max)(); }
+	result_type operator()() { _calls++; return _eng(); }
+
+	long long int calls() const { return _calls; }
+
+private:
+	Engine& _eng;
+	long long int _calls;
+
+};
+
+
+//uniform real in [a, b) built from the top mantissa bits instead of generate_canonical
+//[0, 1) is k * 2^-p for a random p bit integer k (24 bits for float, 53 for double), so 1 can never be returned
+//and no division is needed; a float needs a single call from any engine with 24 or more bits
+template<typename RealType = float>
+class FastRealDistribution
+{
+public:
+	typedef RealType result_type;
+	static const int MANTISSA = std::numeric_limits<RealType>::digits;
+
+	class param_type
+	{
+	public:
+		typedef FastRealDistribution distribution_type;
+		explicit param_type(RealType a = 0, RealType b = 1) : _a(a), _b(b) {}
+		RealType a() const { return _a; }
+		RealType b() const { return _b; }
+		bool operator==(const param_type& p) const { return _a == p._a && _b == p._b; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		RealType _a;
+		RealType _b;
+	};
+
+	explicit FastRealDistribution(RealType a = 0, RealType b = 1) : _param(a, b) {}
+	explicit FastRealDistribution(const param_type& p) : _param(p) {}
+
+	void reset() {}
+	const param_type& param() const { return _param; }
+	void param(const param_type& p) { _param = p; }
+	RealType a() const { return _param.a(); }
+	RealType b() const { return _param.b(); }
+	result_type min() const { return _param.a(); }
+	result_type max() const { return _param.b(); }
+
+	//uniform in [0, 1)
+	template<typename Engine>
+	static RealType canonical(Engine& eng)
+	{
+		return static_cast<RealType>(randomBits(eng, MANTISSA)) * (RealType(1) / static_cast<RealType>(std::uint64_t(1) << MANTISSA));
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng) { return (*this)(eng, _param); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		RealType r = p.a() + (p.b() - p.a()) * canonical(eng);
+		if (r >= p.b()) //scaling can round up to b, [0, 1) itself never does
+			r = std::nextafter(p.b(), p.a());
+		return r;
+	}
+
+private:
+	param_type _param;
+
+};
+
+
+//bernoulli(p) as one engine call compared against a precomputed integer threshold, no conversion to floating point
+//the threshold is p * 2^64 cut down to the bits a single call gives (27 for minstd, 32 for mt19937), so p is resolved to 2^-bits
+class ThresholdBernoulliDistribution
+{
+public:
+	typedef bool result_type;
+
+	class param_type
+	{
+	public:
+		typedef ThresholdBernoulliDistribution distribution_type;
+		explicit param_type(double p = 0.5) : _p(p) {}
+		double p() const { return _p; }
+		bool operator==(const param_type& p) const { return _p == p._p; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		double _p;
+	};
+
+	explicit ThresholdBernoulliDistribution(double p = 0.5) { param(param_type(p)); }
+	explicit ThresholdBernoulliDistribution(const param_type& p) { param(p); }
+
+	void reset() {}
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		_one = p.p() >= 1;
+		//p < 1 keeps p * 2^63 below 2^63, the doubled value loses only a bit a double never had
+		_threshold = _one || p.p() <= 0 ? 0 : static_cast<std::uint64_t>(std::ldexp(p.p(), 63)) << 1;
+	}
+	double p() const { return _param.p(); }
+	result_type min() const { return false; }
+	result_type max() const { return true; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		const int bits = engineBits<Engine>();
+		return _one || randomBits(eng, bits) < _threshold >> (64 - bits);
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	param_type _param;
+	std::uint64_t _threshold;
+	bool _one;
+
+};
+
+
+//bernoulli(p) served from 64 flips per word, p is rounded to d <= 16 binary digits m / 2^d
+//the word for p = 0.5 is a single random word, every further digit of m folds in one more word
+//from the lowest digit up as w | r for a 1 and w & r for a 0, so dyadic p is exact at d words per 64 flips
+class BitmaskBernoulliDistribution
+{
+public:
+	typedef bool result_type;
+	typedef ThresholdBernoulliDistribution::param_type param_type;
+	static const int DIGITS = 16;
+
+	explicit BitmaskBernoulliDistribution(double p = 0.5) { param(param_type(p)); }
+	explicit BitmaskBernoulliDistribution(const param_type& p) { param(p); }
+
+	//drop any flips left in the current word
+	void reset() { _left = 0; }
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		double clamped = p.p() < 0 ? 0 : p.p() > 1 ? 1 : p.p();
+		_mantissa = static_cast<std::uint32_t>(std::floor(std::ldexp(clamped, DIGITS) + 0.5));
+		_digits = DIGITS;
+		while (_digits > 0 && (_mantissa & 1) == 0)
+		{ //trailing zero digits would only spend words on w & 0
+			_mantissa >>= 1;
+			_digits--;
+		}
+		reset();
+	}
+	double p() const { return _param.p(); }
+	result_type min() const { return false; }
+	result_type max() const { return true; }
+
+	//engine words per 64 flips
+	int digits() const { return _digits; }
+
+	//64 independent flips, bit k is flip k
+	template<typename Engine>
+	std::uint64_t word(Engine& eng)
+	{
+		if (_digits == 0) //p rounded to 0 or 1
+			return _mantissa ? ~std::uint64_t(0) : 0;
+		std::uint64_t r = uniformBits<std::uint64_t>(eng); //the lowest digit of m is always 1
+		for (int i = 1; i < _digits; i++)
+		{
+			std::uint64_t w = uniformBits<std::uint64_t>(eng);
+			r = (_mantissa >> i) & 1 ? w | r : w & r;
+		}
+		return r;
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (_left == 0)
+		{
+			_bits = word(eng);
+			_left = 64;
+		}
+		bool flip = _bits & 1;
+		_bits >>= 1;
+		_left--;
+		return flip;
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	param_type _param;
+	std::uint32_t _mantissa;
+	int _digits;
+	std::uint64_t _bits;
+	int _left;
+
+};
+
+
+//poisson with Hormann's PTRS (transformed rejection with squeeze) from a mean of 10, sequential inversion below
+//k = floor((2a / (0.5 - |u|) + b) * u + mean + 0.43) for u uniform in [-0.5, 0.5), the squeeze accepts about 85% of pairs
+//without evaluating any logarithm, the rest are decided by the exact log probability
+template<typename IntType = int>
+class PtrsPoissonDistribution
+{
+public:
+	typedef IntType result_type;
+	static const int INVERSION_MEAN = 10; //below this the search from 0 takes fewer steps than rejection costs
+
+	class param_type
+	{
+	public:
+		typedef PtrsPoissonDistribution distribution_type;
+		explicit param_type(double mean = 1) : _mean(mean) {}
+		double mean() const { return _mean; }
+		bool operator==(const param_type& p) const { return _mean == p._mean; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		double _mean;
+	};
+
+	explicit PtrsPoissonDistribution(double mean = 1) { param(param_type(mean)); }
+	explicit PtrsPoissonDistribution(const param_type& p) { param(p); }
+
+	void reset() {}
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		double mean = p.mean();
+		_expMean = std::exp(-mean);
+		_logMean = std::log(mean);
+		_b = 0.931 + 2.53 * std::sqrt(mean);
+		_a = -0.059 + 0.02483 * _b;
+		_logInvAlpha = std::log(1.1239 + 1.1328 / (_b - 3.4));
+		_vr = 0.9277 - 3.6224 / (_b - 2);
+	}
+	double mean() const { return _param.mean(); }
+	result_type min() const { return 0; }
+	result_type max() const { return (std::numeric_limits<IntType>::max)(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng) { return _param.mean() < INVERSION_MEAN ? invert(eng) : transform(eng); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	template<typename Engine>
+	IntType invert(Engine& eng)
+	{
+		double u = FastRealDistribution<double>::canonical(eng);
+		double p = _expMean;
+		IntType k = 0;
+		while (u > p && p > 0) //p only reaches 0 when rounding left u above the total mass
+		{
+			u -= p;
+			k++;
+			p *= _param.mean() / k;
+		}
+		return k;
+	}
+
+	template<typename Engine>
+	IntType transform(Engine& eng)
+	{
+		for (;;)
+		{
+			double u = FastRealDistribution<double>::canonical(eng) - 0.5;
+			double v = FastRealDistribution<double>::canonical(eng);
+			double us = 0.5 - std::fabs(u);
+			double k = std::floor((2 * _a / us + _b) * u + _param.mean() + 0.43);
+			if (us >= 0.07 && v <= _vr)
+				return static_cast<IntType>(k);
+			if (k < 0 || (us < 0.013 && v > us))
+				continue;
+			if (std::log(v) + _logInvAlpha - std::log(_a / (us * us) + _b) <= -_param.mean() + k * _logMean - std::lgamma(k + 1))
+				return static_cast<IntType>(k);
+		}
+	}
+
+	param_type _param;
+	double _expMean;
+	double _logMean;
+	double _a;
+	double _b;
+	double _logInvAlpha;
+	double _vr;
+
+};
+
+
+//binomial with Hormann's BTRS, the binomial form of PTRS, from t * p of 10 with p folded to p <= 0.5
+//below that the search from 0 steps through (t - k + 1) / k * p / (1 - p)
+template<typename IntType = int>
+class BtrsBinomialDistribution
+{
+public:
+	typedef IntType result_type;
+	static const int INVERSION_MEAN = 10;
+
+	class param_type
+	{
+	public:
+		typedef BtrsBinomialDistribution distribution_type;
+		explicit param_type(IntType t = 1, double p = 0.5) : _t(t), _p(p) {}
+		IntType t() const { return _t; }
+		double p() const { return _p; }
+		bool operator==(const param_type& p) const { return _t == p._t && _p == p._p; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		IntType _t;
+		double _p;
+	};
+
+	explicit BtrsBinomialDistribution(IntType t = 1, double p = 0.5) { param(param_type(t, p)); }
+	explicit BtrsBinomialDistribution(const param_type& p) { param(p); }
+
+	void reset() {}
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		_flip = p.p() > 0.5;
+		double q = _flip ? 1 - p.p() : p.p();
+		double t = static_cast<double>(p.t());
+		_mean = t * q;
+		_ratio = q / (1 - q);
+		_q0 = std::pow(1 - q, t);
+		double spq = std::sqrt(_mean * (1 - q));
+		_b = 1.15 + 2.53 * spq;
+		_a = -0.0873 + 0.0248 * _b + 0.01 * q;
+		_c = _mean + 0.5;
+		_vr = 0.92 - 4.2 / _b;
+		_logAlpha = std::log((2.83 + 5.1 / _b) * spq);
+		_logRatio = std::log(_ratio);
+		_m = std::floor((t + 1) * q);
+		_h = std::lgamma(_m + 1) + std::lgamma(t - _m + 1);
+	}
+	IntType t() const { return _param.t(); }
+	double p() const { return _param.p(); }
+	result_type min() const { return 0; }
+	result_type max() const { return _param.t(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		IntType k = _mean < INVERSION_MEAN ? invert(eng) : transform(eng);
+		return _flip ? _param.t() - k : k;
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	template<typename Engine>
+	IntType invert(Engine& eng)
+	{
+		double u = FastRealDistribution<double>::canonical(eng);
+		double p = _q0;
+		IntType k = 0;
+		while (u > p && k < _param.t())
+		{
+			u -= p;
+			k++;
+			p *= (_param.t() - k + 1) * _ratio / k;
+		}
+		return k;
+	}
+
+	template<typename Engine>
+	IntType transform(Engine& eng)
+	{
+		const double t = static_cast<double>(_param.t());
+		for (;;)
+		{
+			double u = FastRealDistribution<double>::canonical(eng) - 0.5;
+			double v = FastRealDistribution<double>::canonical(eng);
+			double us = 0.5 - std::fabs(u);
+			double k = std::floor((2 * _a / us + _b) * u + _c);
+			if (k < 0 || k > t)
+				continue;
+			if (us >= 0.07 && v <= _vr)
+				return static_cast<IntType>(k);
+			if (std::log(v) + _logAlpha - std::log(_a / (us * us) + _b) <= _h - std::lgamma(k + 1) - std::lgamma(t - k + 1) + (k - _m) * _logRatio)
+				return static_cast<IntType>(k);
+		}
+	}
+
+	param_type _param;
+	bool _flip;
+	double _mean;
+	double _ratio;
+	double _q0;
+	double _a;
+	double _b;
+	double _c;
+	double _vr;
+	double _logAlpha;
+	double _logRatio;
+	double _m;
+	double _h;
+
+};
+
+
+//discrete distribution over [0, n) in O(1) per draw from Vose's alias table
+//each slot packs a 32 bit acceptance threshold with its alias in 8 bytes, so a draw touches a single cache line
+//one 64 bit word picks the slot from the high half of word * n and the coin from the low half, as in Lemire's multiply shift
+template<typename IntType = int>
+class AliasTableDistribution
+{
+public:
+	typedef IntType result_type;
+
+	AliasTableDistribution() { build<const double*>(nullptr, nullptr); }
+	template<typename InputIt>
+	AliasTableDistribution(InputIt first, InputIt last) { build(first, last); }
+
+	//rebuild the table from the weights in [first, last), which need not be normalized
+	template<typename InputIt>
+	void build(InputIt first, InputIt last)
+	{
+		std::vector<double> scaled(first, last);
+		const std::size_t n = scaled.size();
+		_table.assign(n ? n : 1, Slot{ FULL, 0 });
+		double sum = 0;
+		for (double w : scaled)
+			sum += w;
+		if (n == 0 || sum <= 0)
+			return;
+		std::vector<std::uint32_t> small, large;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			scaled[i] = scaled[i] * n / sum;
+			(scaled[i] < 1 ? small : large).push_back(static_cast<std::uint32_t>(i));
+		}
+		while (!small.empty() && !large.empty())
+		{ //the short slot l is topped up to 1 by the tall slot g
+			std::uint32_t l = small.back();
+			std::uint32_t g = large.back();
+			small.pop_back();
+			large.pop_back();
+			_table[l].threshold = static_cast<std::uint32_t>(scaled[l] * 4294967296.0);
+			_table[l].alias = g;
+			scaled[g] = (scaled[g] + scaled[l]) - 1;
+			(scaled[g] < 1 ? small : large).push_back(g);
+		}
+		//whatever is left is 1 up to rounding and keeps its own index
+		for (std::uint32_t i : large)
+			_table[i].alias = i;
+		for (std::uint32_t i : small)
+			_table[i].alias = i;
+	}
+
+	void reset() {}
+	std::size_t size() const { return _table.size(); }
+	//footprint of the table
+	std::size_t bytes() const { return _table.size() * sizeof(Slot); }
+	result_type min() const { return 0; }
+	result_type max() const { return static_cast<IntType>(_table.size() - 1); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		std::uint64_t slot;
+		std::uint64_t coin = mul128(uniformBits<std::uint64_t>(eng), _table.size(), &slot);
+		const Slot& s = _table[static_cast<std::size_t>(slot)];
+		return static_cast<IntType>(coin >> 32 < s.threshold ? slot : s.alias);
+	}
+
+private:
+	static const std::uint32_t FULL = 0xFFFFFFFF; //kept slots alias themselves, so the coin never matters
+
+	struct Slot
+	{
+		std::uint32_t threshold; //keep the slot when the coin is below this, out of 2^32
+		std::uint32_t alias;
+	};
+
+	std::vector<Slot> _table;
+
+};
@@ -1,6 +1,7 @@
 #include <array>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <string>
 #include <sstream>
@@ -9,6 +10,20 @@
 #include <boost\random.hpp>
 #include <boost\chrono\chrono.hpp>
 #include <boost\timer\timer.hpp>
+#include "distributions.h"
+#include "simd.h"
+#include "ziggurat.h"
+#include "gamma.h"
+#include "geometry.h"
+#include "sampling.h"
+#include "approx.h"
+#include "scenario.h"
+#include "isolation.h"
+#include "usage.h"
+#include "cache.h"
+#include "trace.h"
+#include "stress.h"
+#include "sink.h"
 
 
 struct Results //for storing test times
@@ -19,6 +34,89 @@ struct Results //for storing test times
 	long long int mean = 0;
 	float total = 0;
 	float cpuTotal = 0;
+	long long int count = 0; //calls made, used for per call figures of extra rows
+	std::string note = ""; //extra info printed under a row
+	usage::Usage usage; //faults, context switches and allocations of the timed run
+
+};
+
+struct OrderedRun //one repetition of a test and where it ran
+{
+	int position = 0; //place in its pass, 0 is first
+	float score = 0; //per call total of the repetition
+
+};
+
+struct MatrixCell //one entry of the sweep matrix
+{
+	std::string table = "";
+	std::string column = "";
+	double ns = 0; //per variate
+
+};
+
+
+//Results and MatrixCell as text for the results of a child process, strings quoted so notes keep their tabs and line breaks
+inline std::ostream& operator<<(std::ostream& out, const Results& r)
+{
+	return out << std::quoted(r.distribution) << ' ' << r.fastest << ' ' << r.slowest << ' ' << r.mean << ' '
+		<< std::setprecision(std::numeric_limits<float>::max_digits10) << r.total << ' ' << r.cpuTotal << ' ' << r.count << ' ' << std::quoted(r.note) << ' ' << r.usage << '\n';
+}
+
+inline std::istream& operator>>(std::istream& in, Results& r)
+{
+	return in >> std::quoted(r.distribution) >> r.fastest >> r.slowest >> r.mean >> r.total >> r.cpuTotal >> r.count >> std::quoted(r.note) >> r.usage;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const MatrixCell& c)
+{
+	return out << std::quoted(c.table) << ' ' << std::quoted(c.column) << ' ' << std::setprecision(std::numeric_limits<double>::max_digits10) << c.ns << '\n';
+}
+
+inline std::istream& operator>>(std::istream& in, MatrixCell& c)
+{
+	return in >> std::quoted(c.table) >> std::quoted(c.column) >> c.ns;
+}
+
+
+//multiplier of engines with a SIMD lane kernel, 0 if there is none
+template<typename T>
+struct LcgMultiplier { static const std::uint32_t value = 0; };
+
+template<typename U, U a>
+struct LcgMultiplier<std::linear_congruential_engine<U, a, 0, 2147483647>> { static const std::uint32_t value = a; };
+
+template<typename U, U a>
+struct LcgMultiplier<boost::random::linear_congruential_engine<U, a, 0, 2147483647>> { static const std::uint32_t value = a; };
+
+
+//_results index of each test, ENGINE is level 1, the rest are the level 2 and 3 distributions
+enum tests {
+	ENGINE,
+	UNIFORM_INT,
+	NORMAL,
+	BERNOULLI,
+	UNIFORM_INT_BOOST,
+	UNIFORM_INT_LEMIRE,
+	UNIFORM_INT_POOL,
+	UNIFORM_REAL,
+	UNIFORM_REAL_BOOST,
+	UNIFORM_REAL_FAST,
+	UNIFORM_REAL_DOUBLE,
+	UNIFORM_REAL_DOUBLE_FAST,
+	NORMAL_BOOST,
+	NORMAL_ZIGGURAT,
+	NORMAL_DOUBLE,
+	NORMAL_DOUBLE_BOOST,
+	NORMAL_DOUBLE_ZIGGURAT,
+	EXPONENTIAL,
+	EXPONENTIAL_BOOST,
+	EXPONENTIAL_ZIGGURAT,
+	LAPLACE_BOOST,
+	LAPLACE_ZIGGURAT,
+	BERNOULLI_THRESHOLD,
+	BERNOULLI_BITMASK,
+	TEST_COUNT
 
 };
 
@@ -32,32 +130,208 @@ public:
 	virtual bool operator< (const BaseTest& b);
 	virtual const std::string& getDesc() const = 0;
 	virtual std::string getResults() const = 0;
-	virtual const float& getSimpleTotals() const = 0;
+	virtual float getSimpleTotals() const = 0;
+	const std::vector<MatrixCell>& getMatrix() const { return _matrix; }
+	const std::vector<OrderedRun>& getRuns() const { return _runs; }
+
+	//run the test as the position-th of its pass, after the first repetition each row keeps its fastest run
+	//with a child command the run happens in that process instead, a run that fails is counted and left out
+	void runAt(int position, const std::string& child = "");
+	int getFailures() const { return _failures; }
+
+	//write the rows of a run for a parent process, and read them back, load leaves the test as it was if in is bad
+	virtual void save(std::ostream& out) const = 0;
+	virtual bool load(std::istream& in) = 0;
 	
 protected:
-	std::array<Results, 4> _results;
+	std::array<Results, TEST_COUNT> _results;
+	std::vector<MatrixCell> _matrix; //sweep matrix cells, the same tables and columns in the same order for every engine
+	std::vector<OrderedRun> _runs; //every repetition in the order run
+	int _failures = 0; //child processes that crashed or returned nothing
 	static int& level; //reference to global arg for test level
 	static int& iterations; //reference to global arg for iterations per test
 	static int& clock; //reference to global arg for clock stats to display
+	static bool& interleave; //reference to global arg for interleaved engine instances
+	static bool& sweep; //reference to global arg for the distribution parameter sweep
+	static bool& discrete; //reference to global arg for the weighted table sizes
+	static bool& geometry; //reference to global arg for the direction and shape samplers
+	static bool& shuffle; //reference to global arg for the shuffle and k-of-n sampling family
+	static bool& approximate; //reference to global arg for the approximate math distributions
+	static bool& matrix; //reference to global arg for the range, type and parameter sweep matrix
+	static bool& perCall; //reference to global arg for the per-call param_type family
+	static std::vector<Scenario>& scenarios; //reference to global scenarios read from the workload file
+	static int& isa; //reference to global arg for the highest ISA SIMD kernels may use
+	static int& minTime; //reference to global arg for the milliseconds each adaptive test runs, 0 for fixed iterations
+	static int& repetitions; //reference to global arg for the runs of each test
+	static int& order; //reference to global arg for the test order, 0 fixed, 1 round robin, 2 shuffled round robin
+	static unsigned int& orderSeed; //reference to global seed of the shuffled order
+	static bool& isolate; //reference to global arg for a child process per run
+	static bool& resources; //reference to global arg for the usage lines of every row
+	static int& cold; //reference to global arg for the cache cold calls, 0 off, 1 clflush, 2 buffer sweep
+	static bool& traced; //reference to global arg for the per call latency traces
+	static int& stressors; //reference to global arg for the stressor threads of the interference test, 0 off
+	static int& outputSink; //reference to global arg for the memory level 3 writes to
+
+	//sum of the per call totals of every row, unlike operator< which ranks on the three baseline distributions, the
+	//score of a run for the order bias
+	float perCallTotal() const;
 };
 
+float BaseTest::perCallTotal() const
+{
+	float result = 0;
+	for (int i = 0; i < _results.size(); i++)
+		result += _results[i].total / std::max<long long int>(_results[i].count, 1);
+	return result;
+
+}
+
+void BaseTest::runAt(int position, const std::string& child)
+{
+	std::array<Results, TEST_COUNT> kept = _results;
+	if (child.empty())
+		operator()();
+	else
+	{
+		std::string data;
+		std::istringstream in;
+		bool loaded = isolation::runChild(child, stdout, data);
+		in.str(data);
+		if (!loaded || !load(in))
+		{ //the rows keep their earlier runs
+			std::cerr << ">Child process failed for: " << getDesc() << '\n';
+			_failures++;
+			return;
+		}
+	}
+	OrderedRun run;
+	run.position = position;
+	run.score = perCallTotal();
+	_runs.push_back(run);
+	if (_runs.size() > 1)
+		for (int i = 0; i < _results.size(); i++)
+			if (kept[i].total / std::max<long long int>(kept[i].count, 1) < _results[i].total / std::max<long long int>(_results[i].count, 1))
+				_results[i] = kept[i];
+
+}
+
 bool BaseTest::operator< (const BaseTest& b)
 {
 	float resultA = 0;
 	float resultB = 0;
-	for (int i = 1;i < _results.size();i++)
-	{
-		resultA += _results[i].total;
-		resultB += b._results[i].total;
+	for (int i = UNIFORM_INT; i <= BERNOULLI; i++)
+	{ //the three baseline distributions only, per call so tests run with adaptive iteration counts compare fairly
+		resultA += _results[i].total / std::max<long long int>(_results[i].count, 1);
+		resultB += b._results[i].total / std::max<long long int>(b._results[i].count, 1);
 	}
 	if (resultA == resultB)
-		return _results[0].total < b._results[0].total;
+		return getSimpleTotals() < b.getSimpleTotals();
 	else
 		return resultA < resultB;
 
 }
 
 
+//format the sweep matrix, one table per distribution with engines down and parameters across in ns per variate
+inline std::string formatMatrix(const std::vector<std::unique_ptr<BaseTest>>& tests)
+{
+	//the layout of the first engine that has one, an engine whose child process failed has none
+	const std::vector<MatrixCell>* found = nullptr;
+	for (const std::unique_ptr<BaseTest>& test : tests)
+		if (!test->getMatrix().empty())
+		{
+			found = &test->getMatrix();
+			break;
+		}
+	if (!found)
+		return "";
+	std::stringstream stream;
+	const std::vector<MatrixCell>& layout = *found;
+	for (std::size_t first = 0; first < layout.size();)
+	{
+		std::size_t last = first;
+		while (last < layout.size() && layout[last].table == layout[first].table)
+			last++;
+		const std::string title = layout[first].table + " (ns/variate)";
+		stream << std::setfill('-') << title << std::setw(52 - title.size()) << "" << "\n\n"
+			<< std::setfill(' ') << std::left << std::setw(34) << " Engine" << std::right;
+		for (std::size_t c = first; c < last; c++)
+			stream << std::setw(9) << layout[c].column;
+		stream << '\n';
+		for (const std::unique_ptr<BaseTest>& test : tests)
+		{
+			stream << ' ' << std::left << std::setw(33) << test->getDesc() << std::right << std::fixed << std::setprecision(2);
+			for (std::size_t c = first; c < last; c++)
+				if (test->getMatrix().size() == layout.size())
+					stream << std::setw(9) << test->getMatrix()[c].ns;
+				else
+					stream << std::setw(9) << "n/a";
+			stream << '\n';
+		}
+		stream << '\n';
+		first = last;
+	}
+	return stream.str();
+
+}
+
+
+//estimate how much a test's place in its pass moves its time, from repetitions run at different places
+//each run is taken relative to the mean of its own test so engines of different speed can be pooled, then averaged
+//by quarter of the pass and fitted with a least squares line over the position
+inline std::string formatOrderBias(const std::vector<std::unique_ptr<BaseTest>>& tests)
+{
+	const int QUARTERS = 4;
+	std::array<double, QUARTERS> sum = {};
+	std::array<int, QUARTERS> runs = {};
+	double sumP = 0, sumR = 0, sumPP = 0, sumPR = 0;
+	int n = 0;
+	bool moved = false;
+	for (const std::unique_ptr<BaseTest>& test : tests)
+	{
+		const std::vector<OrderedRun>& r = test->getRuns();
+		double mean = 0;
+		for (const OrderedRun& run : r)
+		{
+			mean += run.score;
+			moved = moved || run.position != r[0].position;
+		}
+		mean /= r.size();
+		if (r.size() < 2 || mean <= 0)
+			continue;
+		for (const OrderedRun& run : r)
+		{
+			double relative = run.score / mean - 1;
+			int q = static_cast<int>(run.position * QUARTERS / tests.size());
+			sum[q] += relative;
+			runs[q]++;
+			sumP += run.position;
+			sumR += relative;
+			sumPP += static_cast<double>(run.position) * run.position;
+			sumPR += run.position * relative;
+			n++;
+		}
+	}
+	if (!moved || n < 2)
+		return "";
+	std::stringstream stream;
+	stream << std::setfill('-') << "Order Bias" << std::setw(42) << "" << "\n\n" << std::setfill(' ');
+	for (int q = 0; q < QUARTERS; q++)
+	{
+		std::size_t first = q * tests.size() / QUARTERS + 1;
+		std::size_t last = (q + 1) * tests.size() / QUARTERS;
+		stream << " Positions " << std::setw(2) << first << " - " << std::setw(2) << last << ":\t\t" << std::showpos << std::fixed << std::setprecision(2)
+			<< std::setw(8) << (runs[q] ? sum[q] * 100 / runs[q] : 0.0) << std::noshowpos << " %\n";
+	}
+	double spread = n * sumPP - sumP * sumP;
+	stream << " Slope:\t\t\t\t" << std::showpos << std::setw(8) << std::setprecision(3) << (spread > 0 ? (n * sumPR - sumP * sumR) / spread * 100 : 0.0)
+		<< std::noshowpos << " % per position\n"
+		<< " Runs:\t\t\t\t" << std::setw(8) << n << "\n\n";
+	return stream.str();
+
+}
+
+
 template<typename T = std::minstd_rand>
 class EngineTest final : public BaseTest
 {
@@ -66,10 +340,56 @@ public:
 		_dist1.param(std::uniform_int<int>::param_type(0, 9));
 		_dist2.param(std::normal_distribution<float>::param_type(0, 1));
 		_dist3.param(std::bernoulli_distribution::param_type(.5));
-		_results[0].distribution = "none";
-		_results[1].distribution = "Uniform Integer";
-		_results[2].distribution = "Normal";
-		_results[3].distribution = "Bernoulli";
+		_dist4.param(boost::random::uniform_int_distribution<int>::param_type(0, 9));
+		_dist5.param(LemireIntDistribution<int>::param_type(0, 9));
+		_dist6.param(BitPoolIntDistribution<int>::param_type(0, 9));
+		_dist7.param(std::uniform_real_distribution<float>::param_type(0, 1));
+		_dist9.param(FastRealDistribution<float>::param_type(0, 1));
+		_dist10.param(std::uniform_real_distribution<double>::param_type(0, 1));
+		_dist11.param(FastRealDistribution<double>::param_type(0, 1));
+		_dist12.param(boost::random::normal_distribution<float>::param_type(0, 1));
+		_dist13.selectIsa(isa);
+		_dist14.param(std::normal_distribution<double>::param_type(0, 1));
+		_dist15.param(boost::random::normal_distribution<double>::param_type(0, 1));
+		_dist16.selectIsa(isa);
+		_dist17.param(std::exponential_distribution<float>::param_type(1));
+		_dist18.param(boost::random::exponential_distribution<float>::param_type(1));
+		_dist19.selectIsa(isa);
+		_dist20.param(boost::random::laplace_distribution<float>::param_type(0, 1));
+		_dist21.selectIsa(isa);
+		_dist22.param(ThresholdBernoulliDistribution::param_type(.5));
+		_dist23.param(BitmaskBernoulliDistribution::param_type(.5));
+		_results[ENGINE].distribution = "none";
+		_results[UNIFORM_INT].distribution = "Uniform Integer";
+		_results[NORMAL].distribution = "Normal";
+		_results[BERNOULLI].distribution = "Bernoulli";
+		_results[UNIFORM_INT_BOOST].distribution = "Uniform Integer (boost)";
+		_results[UNIFORM_INT_LEMIRE].distribution = "Uniform Integer (Lemire)";
+		_results[UNIFORM_INT_POOL].distribution = "Uniform Integer (bit pool)";
+		_results[UNIFORM_REAL].distribution = "Uniform Real";
+		_results[UNIFORM_REAL_BOOST].distribution = "Uniform Real (boost uniform_01)";
+		_results[UNIFORM_REAL_FAST].distribution = "Uniform Real (fast)";
+		_results[UNIFORM_REAL_DOUBLE].distribution = "Uniform Real Double";
+		_results[UNIFORM_REAL_DOUBLE_FAST].distribution = "Uniform Real Double (fast)";
+		_results[NORMAL_BOOST].distribution = "Normal (boost ziggurat)";
+		_results[NORMAL_ZIGGURAT].distribution = "Normal (SIMD ziggurat)";
+		_results[NORMAL_DOUBLE].distribution = "Normal Double";
+		_results[NORMAL_DOUBLE_BOOST].distribution = "Normal Double (boost ziggurat)";
+		_results[NORMAL_DOUBLE_ZIGGURAT].distribution = "Normal Double (SIMD ziggurat)";
+		_results[EXPONENTIAL].distribution = "Exponential";
+		_results[EXPONENTIAL_BOOST].distribution = "Exponential (boost ziggurat)";
+		_results[EXPONENTIAL_ZIGGURAT].distribution = "Exponential (SIMD ziggurat)";
+		_results[LAPLACE_BOOST].distribution = "Laplace (boost)";
+		_results[LAPLACE_ZIGGURAT].distribution = "Laplace (SIMD ziggurat)";
+		_results[BERNOULLI_THRESHOLD].distribution = "Bernoulli (integer threshold)";
+		_results[BERNOULLI_BITMASK].distribution = "Bernoulli (64 bit mask)";
+		for (int k = 0; k < _ilpEngs.size(); k++)
+		{ //seed each instance differently so the streams are independent
+			_ilpEngs[k].seed(static_cast<typename T::result_type>(k + 1));
+			_ilpDist1[k].param(_dist1.param());
+			_ilpDist2[k].param(_dist2.param());
+			_ilpDist3[k].param(_dist3.param());
+		}
 		_timer.stop();
 		_totalTimer.stop();
 		}
@@ -82,15 +402,131 @@ public:
 	//format _results and return
 	virtual std::string getResults() const override;
 
-	//return level 0 Totals from _results for faster comparison when sorting
-	virtual const float& getSimpleTotals() const override;
+	//return the level 0 Total per call from _results for faster comparison when sorting
+	virtual float getSimpleTotals() const override;
+
+	virtual void save(std::ostream& out) const override;
+	virtual bool load(std::istream& in) override;
 
 	//format settings and return
 	static std::string getSettings();
 
+	//iterations used and time per call of a _results row, only with a minimum time since the counts then differ per test
+	static std::string adaptiveLines(const Results& r);
+	//faults, context switches and allocations of a row, marked noisy if it was preempted, only with resources
+	static std::string usageLines(const Results& r);
+
 private:
 	void runTest();
 
+	//time distribution x, at level 3 each value is assigned to a vector of V
+	template<typename V, typename D>
+	void timeDistribution(int x, D& dist);
+	//as timeDistribution, but level 3 with clock 2 hands the whole vector to dist.fill
+	template<typename V, typename D>
+	void timeBatch(int x, D& dist);
+	//level 3 of timeDistribution into the output sink instead of a std::vector
+	template<typename V, typename D>
+	void timeSink(int x, D& dist);
+
+	//count the engine calls dist makes on a copy of _eng and note them with the variates per second of _results[x]
+	template<typename D>
+	void noteEngineCalls(int x, D dist);
+
+	//time distribution x of the level 2 and 3 loop
+	void runDistribution(int x);
+	//engine call notes of the rows compared with distribution x, once x and the rows before it have their final runs
+	void noteDistribution(int x);
+	//run test() once, or with a minimum time double iterations until the run takes minTime ms, the last run is kept
+	//iterations is restored afterwards and the count used is kept in _results[x].count
+	template<typename F>
+	void timeAdaptive(int x, F test);
+	static const int MAX_ADAPTIVE = 1 << 26; //keeps a level 3 vector of doubles within 512MB
+
+	//time iterations calls of f(i) for _results[x], per call or as one loop depending on clock
+	template<typename F>
+	void timeLoop(int x, F f);
+
+	//run the level 1-3 loops round robin over K independent engine instances
+	void runInterleaveTest();
+	template<int K>
+	void runInterleaved(std::size_t single);
+
+	//run the SIMD lane kernel of this engine once per ISA up to isa
+	void runSimdTest();
+
+	//time single calls of the engine, and at level 2 and 3 of a few distributions, with their state evicted from the
+	//cache before every call, a row per call noted with the same call timed with the state cached
+	void runColdTest();
+	template<typename F>
+	void timeCold(cache::Evictor& evict, const std::string& name, std::vector<cache::Region> state, F f);
+
+	//time every one of trace::CALLS calls of the engine, and at level 2 and 3 of a few distributions, and note the
+	//period of the slow calls with the size of their spike and their share of the time
+	void runTraceTest();
+	template<typename F>
+	void timeTrace(const std::string& name, F f);
+
+	//time the engine, and at level 2 and 3 uniform int and the SIMD ziggurat normal, with the measuring thread on
+	//cpu 0 and each kind of stressor load on the others, a row per kind and call noted with its slowdown against quiet
+	void runStressTest();
+	//time stress::BLOCKS blocks of calls of f, quiet holds the per call and p99 figures of the quiet row, set when
+	//kind is stress::QUIET and compared against otherwise
+	template<typename F>
+	void timeStress(const std::string& name, int kind, std::array<double, 2>& quiet, F f);
+
+	//time poisson and binomial samplers across means from 0.1 to 10000 and the gamma family across shapes,
+	//one _extra row per sampler and parameter
+	void runSweepTest();
+	template<typename V, typename D>
+	void timeSweep(const std::string& name, D dist);
+	//as timeSweep for a dirichlet, count draws of K components each
+	template<typename D>
+	void timeDirichlet(const std::string& name, D dist);
+
+	//time weighted choice over tables of 8 to 1M random weights, a build row and a draw row per sampler and size
+	void runDiscreteTest();
+	//returns the table it timed the draws of
+	template<typename V, typename B>
+	auto timeTable(const std::string& name, std::size_t n, B build) -> decltype(build());
+
+	//time circle, sphere, disc, cone and triangle samplers per call and the SIMD unit vector batches
+	void runGeometryTest();
+	template<int D>
+	void timeUnitVectorBatch(const std::string& name);
+
+	//time std::shuffle and the batched Fisher-Yates over 52 to 100M elements and k-of-n selection by
+	//Floyd, reservoir and partial shuffle, shuffles are reported per element and selections per k-subset
+	void runShuffleTest();
+
+	//time normal, lognormal, weibull, extreme value, cauchy and exponential from std, from blocks with libm and
+	//from blocks with the 1e-7 and 1e-4 polynomials, each block row noted with its largest error
+	void runApproxTest();
+	template<typename Transform, typename M>
+	void timeApprox(const std::string& name, const Transform& transform);
+
+	//time uniform int over range sizes from 10 to 2^64 in int32, uint32, int64 and uint64, uniform real and normal in
+	//float and double, and bernoulli at p .5 and .01, into _matrix for the engine by engine tables of formatMatrix
+	void runMatrixTest();
+	template<template<typename> class Dist>
+	void timeRanges(const std::string& table);
+	template<typename V, typename D>
+	void timeCell(const std::string& table, const std::string& column, D dist);
+
+	//time uniform int, uniform real, normal and bernoulli with a fresh param_type built from a recorded parameter stream
+	//on every call, each row noted with the fixed parameter figure of the same distribution from _results
+	void runParamTest();
+	template<typename V, typename D, typename P>
+	void timeParams(int fixed, D dist, P param);
+
+	//run each scenario of the workload file as one loop of weighted std distribution draws, a row per scenario
+	void runScenarioTest();
+	void timeScenario(const Scenario& scenario);
+
+	//time count calls of f with _totalTimer and push the result to _extra
+	template<typename F>
+	void timeExtra(const std::string& name, long long int count, F f);
+
 	//conver _totalTimer values and push to _results array struct
 	void convertTotalTimer(int resultsIndex);
 	//creates mean from total
@@ -105,6 +541,34 @@ private:
 	std::uniform_int_distribution<int> _dist1;
 	std::normal_distribution<float> _dist2;
 	std::bernoulli_distribution _dist3;
+	boost::random::uniform_int_distribution<int> _dist4;
+	LemireIntDistribution<int> _dist5;
+	BitPoolIntDistribution<int> _dist6;
+	std::uniform_real_distribution<float> _dist7;
+	boost::random::uniform_01<float> _dist8;
+	FastRealDistribution<float> _dist9;
+	std::uniform_real_distribution<double> _dist10;
+	FastRealDistribution<double> _dist11;
+	boost::random::normal_distribution<float> _dist12;
+	ZigguratNormalDistribution<float> _dist13;
+	std::normal_distribution<double> _dist14;
+	boost::random::normal_distribution<double> _dist15;
+	ZigguratNormalDistribution<double> _dist16;
+	std::exponential_distribution<float> _dist17;
+	boost::random::exponential_distribution<float> _dist18;
+	ZigguratExponentialDistribution<float> _dist19;
+	boost::random::laplace_distribution<float> _dist20;
+	ZigguratLaplaceDistribution<float> _dist21;
+	ThresholdBernoulliDistribution _dist22;
+	BitmaskBernoulliDistribution _dist23;
+
+	//independent instances for the interleave test, K = 1, 2, 4, 8
+	std::array<T, 8> _ilpEngs;
+	std::array<std::uniform_int_distribution<int>, 8> _ilpDist1;
+	std::array<std::normal_distribution<float>, 8> _ilpDist2;
+	std::array<std::bernoulli_distribution, 8> _ilpDist3;
+
+	std::vector<Results> _extra; //results of optional tests, printed after the distributions
 
 	std::string _desc;
 
@@ -112,9 +576,9 @@ private:
 };
 
 template<typename T>
-const float& EngineTest<T>::getSimpleTotals() const
+float EngineTest<T>::getSimpleTotals() const
 {
-	return _results[0].total;
+	return _results[0].total / std::max<long long int>(_results[0].count, 1);
 }
 
 
@@ -126,6 +590,19 @@ std::string EngineTest<T>::getResults() const
 	stream << std::setfill('-') << std::setw(52) << "" << '\n'
 		<< std::setfill(' ') << std::setw((52 - (_desc.size() + 8)) / 2) << "" << "Engine: " << _desc << std::setw((52 - (_desc.size() + 8)) / 2) << "" << '\n'
 		<< std::setfill('-') << std::setw(52) << "" << "\n\n";
+	if (_failures)
+		stream << " Failed Runs:\t\t" << std::setfill(' ') << std::setw(std::numeric_limits<long long int>::digits10) << _failures
+			<< (_runs.empty() ? "  no results" : "") << "\n\n";
+	if (resources)
+	{
+		long long int peak = 0;
+		for (const Results& r : _results)
+			peak = std::max(peak, r.usage.peakRss);
+		for (const Results& r : _extra)
+			peak = std::max(peak, r.usage.peakRss);
+		//the high water mark of the process, one engine's own only when it ran in a process of its own
+		stream << (isolate ? " Peak RSS:\t\t" : " Process Peak RSS:\t") << std::setfill(' ') << std::setw(std::numeric_limits<long long int>::digits10) << peak / 1024 << " KB\n\n";
+	}
 	std::streamsize original = std::cout.precision();
 	switch (level)
 	{
@@ -135,7 +612,7 @@ std::string EngineTest<T>::getResults() const
 			stream << " Fastest:\t\t" << std::setfill(' ') << std::setw(std::numeric_limits<long long int>::digits10) << _results[0].fastest << " ns\n"
 				<< " Slowest:\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << _results[0].slowest << " ns\n"
 				<< " Mean:\t\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << _results[0].mean << " ns\n\n"
-				<< " Total:\t\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[0].total << std::setprecision(original) <<  std::right << " s\n";
+				<< " Total:\t\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[0].total << std::setprecision(original) <<  std::right << " s\n" << adaptiveLines(_results[0]) << usageLines(_results[0]);
 			break;
 		}
 		else if (clock == 2)
@@ -145,7 +622,7 @@ std::string EngineTest<T>::getResults() const
 			float percentage = (_results[0].cpuTotal / _results[0].total) * 100.0f;
 
 			stream << " Real Time:\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[0].total << " s\n"
-				<< " CPU " << std::right << std::setfill(' ') << std::setw(7) << std::setprecision(2) << percentage << std::setprecision(original) << "%:\t\t\t\t" << std::left << std::setfill('0') << std::setprecision(7) << std::setw(9) << _results[0].cpuTotal << std::setprecision(original) << " s\n";
+				<< " CPU " << std::right << std::setfill(' ') << std::setw(7) << std::setprecision(2) << percentage << std::setprecision(original) << "%:\t\t\t\t" << std::left << std::setfill('0') << std::setprecision(7) << std::setw(9) << _results[0].cpuTotal << std::setprecision(original) << " s\n" << adaptiveLines(_results[0]) << usageLines(_results[0]);
 			break;
 		}
 
@@ -155,31 +632,130 @@ std::string EngineTest<T>::getResults() const
 	case 3:
 		if (clock == 1)
 		{
-			for (int x = 1; x < 4; x++)
+			for (int x = 1; x < _results.size(); x++)
 			{
 				stream << std::setfill('-') << _results[x].distribution << std::setw(52 - _results[x].distribution.size()) << "" << "\n\n"
 					<< " Fastest:\t\t" << std::setfill(' ') << std::setw(std::numeric_limits<long long int>::digits10) << _results[x].fastest << " ns\n"
 					<< " Slowest:\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << _results[x].slowest << " ns\n"
 					<< " Mean:\t\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << _results[x].mean << " ns\n\n"
-					<< " Total:\t\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[x].total << std::setprecision(original) << std::right << " s\n\n";
+					<< " Total:\t\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[x].total << std::setprecision(original) << std::right << " s\n" << adaptiveLines(_results[x]) << usageLines(_results[x]) << '\n';
+				if (!_results[x].note.empty())
+					stream << ' ' << _results[x].note << '\n';
 			}
 			break;
 		}
 		else if (clock == 2)
 		{
 			
-			for (int x = 1; x < 4; x++)
+			for (int x = 1; x < _results.size(); x++)
 			{
 				float percentage = (_results[x].cpuTotal / _results[x].total) * 100.0f;
 
 				stream << std::setfill('-') << _results[x].distribution << std::setw(52 - _results[x].distribution.size()) << "" << "\n\n"
 					<< " Real Time:\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _results[x].total << " s\n"
-					<< " CPU " << std::right << std::setfill(' ') << std::setw(7) << std::setprecision(2) << percentage << std::setprecision(original) << "%:\t\t\t\t" << std::left << std::setfill('0') << std::setprecision(7) << std::setw(9) << _results[x].cpuTotal << std::setprecision(original) << " s\n\n";
+					<< " CPU " << std::right << std::setfill(' ') << std::setw(7) << std::setprecision(2) << percentage << std::setprecision(original) << "%:\t\t\t\t" << std::left << std::setfill('0') << std::setprecision(7) << std::setw(9) << _results[x].cpuTotal << std::setprecision(original) << " s\n" << adaptiveLines(_results[x]) << usageLines(_results[x]) << '\n';
+				if (!_results[x].note.empty())
+					stream << ' ' << _results[x].note << '\n';
 			}
 			break;
 		}
 
 	}
+
+	if (level == 1 && !_extra.empty())
+		stream << '\n';
+	for (int x = 0; x < _extra.size(); x++)
+	{
+		stream << std::setfill('-') << _extra[x].distribution << std::setw(52 - _extra[x].distribution.size()) << "" << "\n\n"
+			<< " Real Time:\t\t\t\t" << std::left << std::setfill('0') << std::fixed << std::setprecision(7) << std::setw(9) << _extra[x].total << std::right << " s\n"
+			<< " Per Call:\t\t" << std::setfill(' ') << std::setw(std::numeric_limits<long long int>::digits10) << std::setprecision(2) << (_extra[x].count ? _extra[x].total * 1000000000.0 / _extra[x].count : 0.0) << std::setprecision(original) << " ns\n"
+			<< usageLines(_extra[x]);
+		if (!_extra[x].note.empty())
+			stream << ' ' << _extra[x].note << '\n';
+		stream << '\n';
+	}
+	return stream.str();
+
+}
+
+template<typename T>
+void EngineTest<T>::save(std::ostream& out) const
+{
+	for (const Results& r : _results)
+		out << r;
+	out << _extra.size() << '\n';
+	for (const Results& r : _extra)
+		out << r;
+	out << _matrix.size() << '\n';
+	for (const MatrixCell& c : _matrix)
+		out << c;
+	out << sink::hugeState() << '\n'; //only the child allocated, so only it knows what huge pages it got
+
+}
+
+template<typename T>
+bool EngineTest<T>::load(std::istream& in)
+{
+	const std::size_t MAX_ROWS = 1 << 16; //far more than any run makes, a bad count fails instead of allocating
+	std::array<Results, TEST_COUNT> results;
+	std::vector<Results> extra;
+	std::vector<MatrixCell> matrix;
+	std::size_t n;
+	for (Results& r : results)
+		if (!(in >> r))
+			return false;
+	if (!(in >> n) || n > MAX_ROWS)
+		return false;
+	extra.resize(n);
+	for (Results& r : extra)
+		if (!(in >> r))
+			return false;
+	if (!(in >> n) || n > MAX_ROWS)
+		return false;
+	matrix.resize(n);
+	for (MatrixCell& c : matrix)
+		if (!(in >> c))
+			return false;
+	int huge;
+	if (!(in >> huge) || huge < sink::HUGE_UNKNOWN || huge > sink::HUGE_UNAVAILABLE)
+		return false;
+	if (huge != sink::HUGE_UNKNOWN)
+		sink::hugeState() = huge;
+	_results = results;
+	_extra = extra;
+	_matrix = matrix;
+	return true;
+
+}
+
+template<typename T>
+std::string EngineTest<T>::adaptiveLines(const Results& r)
+{
+	if (minTime == 0)
+		return "";
+	std::stringstream stream;
+	stream << " Iterations:\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << r.count << '\n'
+		<< " Per Call:\t\t" << std::setw(std::numeric_limits<long long int>::digits10) << std::fixed << std::setprecision(2) << (r.count ? r.total * 1000000000.0 / r.count : 0.0) << " ns\n";
+	return stream.str();
+
+}
+
+template<typename T>
+std::string EngineTest<T>::usageLines(const Results& r)
+{
+	if (!resources)
+		return "";
+	const int width = std::numeric_limits<long long int>::digits10;
+	std::stringstream stream;
+	stream << " Page Faults:\t\t" << std::setfill(' ') << std::setw(width) << r.usage.minorFaults << " minor, " << r.usage.majorFaults << " major\n"
+		<< " Context Switches:\t";
+	if (usage::SWITCHES)
+		stream << std::setw(width) << r.usage.voluntarySwitches << " voluntary, " << r.usage.involuntarySwitches << " involuntary\n";
+	else
+		stream << std::setw(width) << "n/a" << '\n';
+	stream << " Allocations:\t\t" << std::setw(width) << r.usage.allocations << ", " << r.usage.allocatedBytes << " bytes\n";
+	if (r.usage.involuntarySwitches > 0)
+		stream << " Noisy:\t\t\t" << std::setw(width) << "yes" << ", preempted during the run\n";
 	return stream.str();
 
 }
@@ -196,6 +772,65 @@ std::string EngineTest<T>::getSettings()
 	else
 		stream << "no";
 	stream << '\n';
+	if (level == 3 && outputSink != sink::VECTOR)
+	{
+		stream << "Output Sink:  " << sink::kindName(outputSink);
+		if (outputSink == sink::HUGE_PAGES)
+		{
+			const char* states[4] = { " (not known, no run reported)", " (reserved)", " (transparent)", " (unavailable, normal pages)" };
+			stream << states[sink::hugeState()];
+		}
+		stream << '\n';
+	}
+	if (repetitions > 1 || order)
+	{
+		const char* orders[3] = { "fixed, repetitions back to back", "round robin", "shuffled round robin" };
+		stream << "Repetitions:  " << repetitions << ", fastest kept, " << orders[order];
+		if (order == 2)
+			stream << " (seed " << orderSeed << ")";
+		stream << '\n';
+	}
+	if (isolate)
+		stream << "Isolation:  a child process per run, pinned to cpu " << isolation::childCpu() << '\n';
+	if (cold)
+		stream << "Cache Cold Calls:  " << (cold == 1 && SIMD_X86 ? "clflush of engine and distribution state, " : "sweep of 64MB before each call, ")
+			<< (cold == 1 && SIMD_X86 ? cache::FLUSH_CALLS : cache::SWEEP_CALLS) << " calls per row\n";
+	if (traced)
+		stream << "Latency Traces:  " << trace::CALLS << " calls per row, periods of 2 - " << trace::MAX_PERIOD << " calls\n";
+	if (stressors)
+		stream << "Interference:  " << stressors << " stressor thread" << (stressors > 1 ? "s" : "") << " from cpu " << stress::stressorCpu(0)
+			<< ", measured on cpu 0 in blocks of " << stress::BLOCK << " calls\n";
+	if (resources)
+		stream << "Resource Usage:  page faults, " << (usage::SWITCHES ? "context switches, " : "") << "peak RSS, operator new calls per row\n";
+	if (minTime)
+		stream << "Minimum Time:  " << minTime << " ms per test, iterations doubled from the count above\n";
+	if (interleave)
+		stream << "Interleaved Instances:  1, 2, 4, 8\n";
+	if (sweep)
+		stream << "Parameter Sweep:  poisson/binomial means 0.1 - 10000, gamma family shapes 0.5 - 100\n";
+	if (discrete)
+		stream << "Discrete Tables:  8 - 1048576 weights\n";
+	if (geometry)
+		stream << "Geometry:  circle, sphere, disc, cone, triangle\n";
+	if (shuffle)
+		stream << "Shuffle:  52 - 100000000 elements, k of 1000000\n";
+	if (approximate)
+		stream << "Approximate Math:  1e-4 and 1e-7 polynomials against libm\n";
+	if (matrix)
+		stream << "Sweep Matrix:  ranges 10 - 2^64, int32/int64/float/double, bernoulli p .5/.01\n";
+	if (perCall)
+		stream << "Per-Call Params:  4096 recorded ranges, spans, means and p, one per call\n";
+	if (!scenarios.empty())
+	{
+		stream << "Scenarios:  ";
+		for (std::size_t i = 0; i < scenarios.size(); i++)
+			stream << (i ? ", " : "") << scenarios[i].name;
+		stream << '\n';
+	}
+	stream << "SIMD:  " << simd::isaName(isa);
+	if (isa != simd::detectIsa())
+		stream << " (forced, detected " << simd::isaName(simd::detectIsa()) << ")";
+	stream << '\n';
 	return stream.str();
 
 }
@@ -204,218 +839,1116 @@ std::string EngineTest<T>::getSettings()
 template<typename T>
 void EngineTest<T>::runTest() 
 {
+	//optional rows are rebuilt by every repetition, so only the last is reported
+	_extra.clear();
+	_matrix.clear();
 	
-	bool initialized = false;
 	switch (level)
 	{
 	case 1:
 		std::cout << ">Starting test for: " << _desc << "...";
-		
-		if(clock == 1)
-		{ //clock variant 1
-			for (int i = 0; i < iterations; i++)
-			{ //run test
-				_timer.elapsed().clear();
-				_timer.start();
-				_eng();
-				_timer.stop();
-				long long int thisIt = _timer.elapsed().wall;
-				if (!initialized)
-				{
-					_results[0].fastest = thisIt;
-					initialized = true;
-				}
-				//keep track of fastest and slowest
-				if (_results[0].fastest > thisIt)
-				   	_results[0].fastest = thisIt;
-				if (_results[0].slowest < thisIt)
-					_results[0].slowest = thisIt;
-				_results[0].total += thisIt / 1000000000.0; //keep accumulating total time
-			}
-			convertResultsMean(0); //convert total to mean
-		}
-		else if (clock == 2)
-		{ //clock variant 2
-			_totalTimer.elapsed().clear();
-			_totalTimer.start();
-			for (int i = 0; i < iterations; i++)
-				_eng();
-			_totalTimer.stop();
-			convertTotalTimer(0); //convert timer and push to _results array struct
-		}	
-		
+		timeAdaptive(ENGINE, [&]() { timeLoop(ENGINE, [&](int) { _eng(); }); });
 		std::cout << "done!\n";
-
 		break;
 	case 2:
-		std::cout << ">Starting test for: " << _desc << '\n';
-		for (int x = 1; x < 4; x++)
-		{ //for each distribution starting at _results[1] to _results[4] as x
-			std::cout << ">" << x << "/3...";
-			if (clock == 1)
-			{ //clock variant 1
-				for (int i = 0; i < iterations; i++)
-				{ //run test for x
-
-					switch (x) {
-					case 1:
-						_timer.elapsed().clear();
-						_timer.start();
-						_dist1(_eng);
-						_timer.stop();
-						break;
-					case 2:
-						_timer.elapsed().clear();
-						_timer.start();
-						_dist2(_eng);
-						_timer.stop();
-						break;
-					case 3:
-						_timer.elapsed().clear();
-						_timer.start();
-						_dist3(_eng);
-						_timer.stop();
-						break;
-					}
-					long long int thisIt = _timer.elapsed().wall;
-					if (!initialized)
-					{
-						_results[x].fastest = thisIt;
-						initialized = true;
-					}
-					if (_results[x].fastest > thisIt)
-						_results[x].fastest = thisIt;
-					if (_results[x].slowest < thisIt)
-						_results[x].slowest = thisIt;
-					_results[x].total += thisIt / 1000000000.0;
-
-				}
-				convertResultsMean(x);
-			}
-			else if (clock == 2)
-			{ // clock variant 2
-				switch (x) {  //run test for x
-				case 1:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						_dist1(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				case 2:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						_dist2(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				case 3:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						_dist3(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				}
+		//fall through to case 3
 
-			}
+	case 3:
+		std::cout << ">Starting test for: " << _desc << '\n';
+		for (int x = 1; x < TEST_COUNT; x++)
+		{ //for each distribution starting at _results[1] as x
+			std::cout << ">" << x << "/" << TEST_COUNT - 1 << "...";
+			timeAdaptive(x, [&]() { runDistribution(x); });
+			noteDistribution(x);
 			std::cout << "done!\n";
 		}
+		break;
+	}
 
+	if (interleave)
+		runInterleaveTest();
+	if (cold)
+		runColdTest();
+	if (traced)
+		runTraceTest();
+	if (stressors)
+		runStressTest();
+	if (sweep && level > 1)
+		runSweepTest();
+	if (discrete && level > 1)
+		runDiscreteTest();
+	if (geometry && level > 1)
+		runGeometryTest();
+	if (shuffle && level > 1)
+		runShuffleTest();
+	if (approximate && level > 1)
+		runApproxTest();
+	if (matrix && level > 1)
+		runMatrixTest();
+	if (perCall && level > 1)
+		runParamTest();
+	if (!scenarios.empty() && level > 1)
+		runScenarioTest();
+	if (level == 1 && LcgMultiplier<T>::value != 0)
+		runSimdTest();
+}
+
+template<typename T>
+void EngineTest<T>::runDistribution(int x)
+{
+	switch (x) {
+	case UNIFORM_INT:
+		timeDistribution<int>(x, _dist1);
 		break;
-	case 3:
-		std::cout << ">Starting test for: " << _desc << '\n';
-		for (int x = 1; x < 4; x++) { //for each distribution starting at _results[1] to _results[4] as x
-			std::cout << ">" << x << "/3...";		
-			//if test is x, resize apropriate array to right size
-			std::vector<int> intVec;
-			if(x==1)
-				intVec.resize(iterations);
-			std::vector<float> floatVec;
-			if(x==2)
-				floatVec.resize(iterations);
-			std::vector<bool> boolVec;
-			if(x==3)
-				boolVec.resize(iterations);
-			if (clock == 1)
-			{ //clock variant 1
-				for (int i = 0; i < iterations; i++)
-				{ //run test for x
-
-					switch (x) {
-					case 1:
-						_timer.elapsed().clear();
-						_timer.start();
-						intVec[i] = _dist1(_eng);
-						_timer.stop();
-						break;
-					case 2:
-						_timer.elapsed().clear();
-						_timer.start();
-						floatVec[i] = _dist2(_eng);
-						_timer.stop();
-						break;
-					case 3:
-						_timer.elapsed().clear();
-						_timer.start();
-						boolVec[i] = _dist3(_eng);
-						_timer.stop();
-						break;
-					}
-					long long int thisIt = _timer.elapsed().wall;
-					if (!initialized)
-					{
-						_results[x].fastest = thisIt;
-						initialized = true;
-					}
-					if (_results[x].fastest > thisIt)
-						_results[x].fastest = thisIt;
-					if (_results[x].slowest < thisIt)
-						_results[x].slowest = thisIt;
-					_results[x].total += thisIt / 1000000000.0;
-
-				}
-				convertResultsMean(x);
-			}
+	case NORMAL:
+		timeDistribution<float>(x, _dist2);
+		break;
+	case BERNOULLI:
+		timeDistribution<bool>(x, _dist3);
+		break;
+	case UNIFORM_INT_BOOST:
+		timeDistribution<int>(x, _dist4);
+		break;
+	case UNIFORM_INT_LEMIRE:
+		timeDistribution<int>(x, _dist5);
+		break;
+	case UNIFORM_INT_POOL:
+		timeDistribution<int>(x, _dist6);
+		break;
+	case UNIFORM_REAL:
+		timeDistribution<float>(x, _dist7);
+		break;
+	case UNIFORM_REAL_BOOST:
+		timeDistribution<float>(x, _dist8);
+		break;
+	case UNIFORM_REAL_FAST:
+		timeDistribution<float>(x, _dist9);
+		break;
+	case UNIFORM_REAL_DOUBLE:
+		timeDistribution<double>(x, _dist10);
+		break;
+	case UNIFORM_REAL_DOUBLE_FAST:
+		timeDistribution<double>(x, _dist11);
+		break;
+	case NORMAL_BOOST:
+		timeDistribution<float>(x, _dist12);
+		break;
+	case NORMAL_ZIGGURAT:
+		timeBatch<float>(x, _dist13);
+		break;
+	case NORMAL_DOUBLE:
+		timeDistribution<double>(x, _dist14);
+		break;
+	case NORMAL_DOUBLE_BOOST:
+		timeDistribution<double>(x, _dist15);
+		break;
+	case NORMAL_DOUBLE_ZIGGURAT:
+		timeBatch<double>(x, _dist16);
+		break;
+	case EXPONENTIAL:
+		timeDistribution<float>(x, _dist17);
+		break;
+	case EXPONENTIAL_BOOST:
+		timeDistribution<float>(x, _dist18);
+		break;
+	case EXPONENTIAL_ZIGGURAT:
+		timeBatch<float>(x, _dist19);
+		break;
+	case LAPLACE_BOOST:
+		timeDistribution<float>(x, _dist20);
+		break;
+	case LAPLACE_ZIGGURAT:
+		timeBatch<float>(x, _dist21);
+		break;
+	case BERNOULLI_THRESHOLD:
+		timeDistribution<bool>(x, _dist22);
+		break;
+	case BERNOULLI_BITMASK:
+		timeDistribution<bool>(x, _dist23);
+		break;
+	}
+}
+
+template<typename T>
+void EngineTest<T>::noteDistribution(int x)
+{
+	switch (x) {
+	case UNIFORM_INT_POOL:
+		noteEngineCalls(UNIFORM_INT, _dist1);
+		noteEngineCalls(x, _dist6);
+		break;
+	case BERNOULLI_THRESHOLD:
+		noteEngineCalls(BERNOULLI, _dist3);
+		noteEngineCalls(x, _dist22);
+		break;
+	case BERNOULLI_BITMASK:
+		noteEngineCalls(x, _dist23);
+		break;
+	}
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeAdaptive(int x, F test)
+{
+	const int requested = iterations;
+	for (;;)
+	{
+		_results[x].fastest = 0;
+		_results[x].slowest = 0;
+		_results[x].mean = 0;
+		_results[x].total = 0;
+		_results[x].cpuTotal = 0;
+		test();
+		if (minTime == 0 || _results[x].total * 1000 >= minTime || iterations >= MAX_ADAPTIVE)
+			break;
+		iterations = std::min(iterations * 2, MAX_ADAPTIVE);
+	}
+	_results[x].count = iterations;
+	iterations = requested;
+}
+
+template<typename T>
+void EngineTest<T>::runSimdTest()
+{
+	std::cout << ">SIMD lanes for: " << _desc << "...";
+	typedef simd::LcgLanes<LcgMultiplier<T>::value> Lanes;
+	std::vector<std::uint32_t> block(1024); //small enough to stay in L1
+	const long long int count = iterations - iterations % simd::LCG_LANES;
+	for (int i = simd::ISA_SCALAR; i <= isa; i++)
+	{
+		if (Lanes::kernels().resolve(i) != i)
+			continue; //not compiled for this target
+		Lanes lanes(i);
+		timeExtra("SIMD x16 " + simd::isaName(i), count, [&]() {
+			for (long long int done = 0; done < count; done += block.size())
+				lanes.fill(block.data(), static_cast<std::size_t>(std::min<long long int>(block.size(), count - done)));
+		});
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+void EngineTest<T>::runColdTest()
+{
+	std::cout << ">Cache cold calls for: " << _desc << "...";
+	cache::Evictor evict(cold == 2);
+	timeCold(evict, "engine()", {}, [&]() { _eng(); });
+	if (level > 1)
+	{
+		timeCold(evict, _results[UNIFORM_INT].distribution, { cache::region(_dist1) }, [&]() { _dist1(_eng); });
+		timeCold(evict, _results[UNIFORM_REAL].distribution, { cache::region(_dist7) }, [&]() { _dist7(_eng); });
+		timeCold(evict, _results[BERNOULLI].distribution, { cache::region(_dist3) }, [&]() { _dist3(_eng); });
+		timeCold(evict, _results[NORMAL].distribution, { cache::region(_dist2) }, [&]() { _dist2(_eng); });
+		timeCold(evict, _results[NORMAL_ZIGGURAT].distribution, { cache::region(_dist13), cache::region(zig::Table<zig::NormalShape, float>::get()) },
+			[&]() { _dist13(_eng); });
+		timeCold(evict, _results[EXPONENTIAL_ZIGGURAT].distribution, { cache::region(_dist19), cache::region(zig::Table<zig::ExponentialShape, float>::get()) },
+			[&]() { _dist19(_eng); });
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeCold(cache::Evictor& evict, const std::string& name, std::vector<cache::Region> state, F f)
+{
+	//a cpu_timer reads the process times on every start, a steady clock alone is cheap enough for a single call
+	typedef boost::chrono::high_resolution_clock Clock;
+	const int calls = evict.sweeps() ? cache::SWEEP_CALLS : cache::FLUSH_CALLS;
+	state.push_back(cache::region(_eng));
+	Clock::duration hot = Clock::duration::zero();
+	Clock::duration cold = Clock::duration::zero();
+	for (int i = 0; i < calls; i++)
+	{
+		Clock::time_point start = Clock::now();
+		f();
+		hot += Clock::now() - start;
+	}
+	for (int i = 0; i < calls; i++)
+	{
+		evict(state);
+		Clock::time_point start = Clock::now();
+		f();
+		cold += Clock::now() - start;
+	}
+	double hotNs = boost::chrono::duration<double, boost::nano>(hot).count() / calls;
+	double coldNs = boost::chrono::duration<double, boost::nano>(cold).count() / calls;
+	Results result;
+	result.distribution = "Cold " + name;
+	result.count = calls;
+	result.total = static_cast<float>(coldNs * calls / 1000000000.0);
+	std::stringstream note;
+	note << std::fixed << std::setprecision(2) << "Cached Call:\t\t" << hotNs << " ns\n Cold Penalty:\t\t" << coldNs - hotNs << " ns";
+	result.note = note.str();
+	_extra.push_back(result);
+}
+
+template<typename T>
+void EngineTest<T>::runTraceTest()
+{
+	std::cout << ">Latency traces for: " << _desc << "...";
+	timeTrace("engine()", [&]() { _eng(); });
+	if (level > 1)
+	{
+		timeTrace(_results[UNIFORM_INT].distribution, [&]() { _dist1(_eng); });
+		timeTrace(_results[NORMAL].distribution, [&]() { _dist2(_eng); });
+		timeTrace(_results[NORMAL_BOOST].distribution, [&]() { _dist12(_eng); });
+		timeTrace(_results[NORMAL_ZIGGURAT].distribution, [&]() { _dist13(_eng); });
+		timeTrace(_results[EXPONENTIAL_ZIGGURAT].distribution, [&]() { _dist19(_eng); });
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeTrace(const std::string& name, F f)
+{
+	typedef boost::chrono::high_resolution_clock Clock;
+	std::vector<Clock::time_point> stamps(trace::CALLS + 1);
+	//back to back stamps with nothing between them, the part of every traced call that is the clock
+	for (int i = 0; i < trace::CALLS; i++)
+		stamps[i] = Clock::now();
+	std::vector<double> overhead(trace::CALLS - 1);
+	for (int i = 1; i < trace::CALLS; i++)
+		overhead[i - 1] = boost::chrono::duration<double, boost::nano>(stamps[i] - stamps[i - 1]).count();
+	const double clockNs = trace::quantile(overhead, 0.5);
+	//each call is the gap between two stamps, so one clock read per call
+	stamps[0] = Clock::now();
+	for (int i = 1; i <= trace::CALLS; i++)
+	{
+		f();
+		stamps[i] = Clock::now();
+	}
+	std::vector<double> ns(trace::CALLS);
+	double total = 0;
+	for (int i = 0; i < trace::CALLS; i++)
+	{
+		ns[i] = boost::chrono::duration<double, boost::nano>(stamps[i + 1] - stamps[i]).count();
+		total += ns[i];
+	}
+	trace::Periodicity p = trace::analyze(ns);
+	Results result;
+	result.distribution = "Trace " + name;
+	result.count = trace::CALLS;
+	result.total = static_cast<float>(total / 1000000000.0);
+	std::stringstream note;
+	note << std::fixed << std::setprecision(2);
+	if (p.period)
+		note << "Spike Period:\t\t" << p.period << " calls, autocorrelation " << p.correlation << '\n';
+	else
+		note << "Spike Period:\t\tnone, outliers only\n";
+	note << " Typical Call:\t\t" << p.typical << " ns, " << clockNs << " ns of it the clock\n"
+		<< " Spike:\t\t\t+" << p.spike << " ns\n"
+		<< " Time in Spikes:\t" << p.fraction * 100 << " %";
+	result.note = note.str();
+	_extra.push_back(result);
+}
+
+template<typename T>
+void EngineTest<T>::runStressTest()
+{
+	std::cout << ">Interference for: " << _desc << "...";
+	stress::Pin pin(0);
+	std::array<std::array<double, 2>, 3> quiet;
+	for (int k = stress::QUIET; k < stress::KIND_COUNT; k++)
+	{
+		stress::Stressors load(k, stressors);
+		const std::string kind = stress::kindName(k) + " ";
+		timeStress(kind + "engine()", k, quiet[0], [&]() { _eng(); });
+		if (level > 1)
+		{
+			timeStress(kind + _results[UNIFORM_INT].distribution, k, quiet[1], [&]() { _dist1(_eng); });
+			timeStress(kind + _results[NORMAL_ZIGGURAT].distribution, k, quiet[2], [&]() { _dist13(_eng); });
+		}
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeStress(const std::string& name, int kind, std::array<double, 2>& quiet, F f)
+{
+	typedef boost::chrono::high_resolution_clock Clock;
+	std::vector<double> blocks(stress::BLOCKS);
+	double total = 0;
+	for (int b = 0; b < stress::BLOCKS; b++)
+	{
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < stress::BLOCK; i++)
+			f();
+		blocks[b] = boost::chrono::duration<double, boost::nano>(Clock::now() - start).count() / stress::BLOCK;
+		total += blocks[b] * stress::BLOCK;
+	}
+	const double perCall = total / (static_cast<double>(stress::BLOCKS) * stress::BLOCK);
+	const double p50 = trace::quantile(blocks, 0.5);
+	const double p99 = trace::quantile(blocks, 0.99);
+	if (kind == stress::QUIET)
+	{
+		quiet[0] = perCall;
+		quiet[1] = p99;
+	}
+	Results result;
+	result.distribution = name;
+	result.count = static_cast<long long int>(stress::BLOCKS) * stress::BLOCK;
+	result.total = static_cast<float>(total / 1000000000.0);
+	std::stringstream note;
+	note << std::fixed << std::setprecision(2) << "Median Block:\t\t" << p50 << " ns per call\n"
+		<< " p99 Block:\t\t" << p99 << " ns per call";
+	if (kind != stress::QUIET && quiet[0] > 0 && quiet[1] > 0)
+		note << "\n Slowdown:\t\t" << std::showpos << (perCall / quiet[0] - 1) * 100 << " % per call, "
+			<< (p99 / quiet[1] - 1) * 100 << " % p99" << std::noshowpos;
+	result.note = note.str();
+	_extra.push_back(result);
+}
+
+template<typename T>
+void EngineTest<T>::runSweepTest()
+{
+	std::cout << ">Sweeping distribution parameters for: " << _desc << "...";
+	//both sides of the inversion to rejection switch at a mean of 10 (11 for the boost binomial)
+	const double means[] = { 0.1, 1, 5, 10, 30, 100, 1000, 10000 };
+	const int trials = 20000; //binomial p = mean / trials, so p stays at or below 0.5
+	for (double mean : means)
+	{
+		std::stringstream label;
+		label << " mean " << mean;
+		timeSweep<int>("Poisson" + label.str(), std::poisson_distribution<int>(mean));
+		timeSweep<int>("Poisson (boost PTRD)" + label.str(), boost::random::poisson_distribution<int>(mean));
+		timeSweep<int>("Poisson (PTRS)" + label.str(), PtrsPoissonDistribution<int>(mean));
+		timeSweep<int>("Binomial" + label.str(), std::binomial_distribution<int>(trials, mean / trials));
+		timeSweep<int>("Binomial (boost BTRD)" + label.str(), boost::random::binomial_distribution<int>(trials, mean / trials));
+		timeSweep<int>("Binomial (BTRS)" + label.str(), BtrsBinomialDistribution<int>(trials, mean / trials));
+	}
+
+	//alpha < 1 takes the u^(1 / alpha) path, 1 is the exponential case, the rest walk the squeeze towards normal
+	const float shapes[] = { 0.5f, 1, 2.5f, 10, 100 };
+	const int components = 4; //dirichlet K
+	for (float a : shapes)
+	{
+		std::stringstream label;
+		label << " shape " << a;
+		timeSweep<float>("Gamma" + label.str(), std::gamma_distribution<float>(a, 1));
+		timeSweep<float>("Gamma (boost)" + label.str(), boost::random::gamma_distribution<float>(a, 1));
+		timeSweep<float>("Gamma (Marsaglia-Tsang)" + label.str(), FastGammaDistribution<float>(a, 1, isa));
+		timeSweep<float>("Beta (boost)" + label.str(), boost::random::beta_distribution<float>(a, a));
+		timeSweep<float>("Beta (Marsaglia-Tsang)" + label.str(), FastBetaDistribution<float>(a, a, isa));
+		timeSweep<float>("Chi-Squared" + label.str(), std::chi_squared_distribution<float>(2 * a));
+		timeSweep<float>("Chi-Squared (boost)" + label.str(), boost::random::chi_squared_distribution<float>(2 * a));
+		timeSweep<float>("Chi-Squared (Marsaglia-Tsang)" + label.str(), FastChiSquaredDistribution<float>(2 * a, isa));
+		timeSweep<float>("Student t" + label.str(), std::student_t_distribution<float>(2 * a));
+		timeSweep<float>("Student t (boost)" + label.str(), boost::random::student_t_distribution<float>(2 * a));
+		timeSweep<float>("Student t (Marsaglia-Tsang)" + label.str(), FastStudentTDistribution<float>(2 * a, isa));
+		timeDirichlet("Dirichlet K4" + label.str(), DirichletDistribution<float, std::gamma_distribution<float>>(components, a));
+		timeDirichlet("Dirichlet K4 (boost gamma)" + label.str(), DirichletDistribution<float, boost::random::gamma_distribution<float>>(components, a));
+		timeDirichlet("Dirichlet K4 (Marsaglia-Tsang)" + label.str(), DirichletDistribution<float>(components, a));
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename V, typename D>
+void EngineTest<T>::timeSweep(const std::string& name, D dist)
+{
+	if (level == 2)
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				dist(_eng);
+		});
+	else
+	{
+		std::vector<V> vec(iterations);
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				vec[i] = dist(_eng);
+		});
+	}
+}
+
+template<typename T>
+template<typename D>
+void EngineTest<T>::timeDirichlet(const std::string& name, D dist)
+{
+	//the components always land in a buffer, level 3 spreads them over a vector of K * iterations
+	const int k = dist.size();
+	std::vector<float> vec(level == 3 ? static_cast<std::size_t>(iterations) * k : k);
+	timeExtra(name, iterations, [&]() {
+		for (int i = 0; i < iterations; i++)
+			dist(_eng, vec.begin() + (level == 3 ? static_cast<std::size_t>(i) * k : 0));
+	});
+}
+
+template<typename T>
+void EngineTest<T>::runDiscreteTest()
+{
+	std::cout << ">Weighted tables for: " << _desc << "...";
+	//8 weights fit a cache line, 1M outgrow L2 so draws pay for cache misses
+	const std::size_t sizes[] = { 8, 64, 512, 4096, 32768, 262144, 1048576 };
+	for (std::size_t n : sizes)
+	{
+		std::vector<double> weights(n);
+		std::mt19937 gen(static_cast<std::mt19937::result_type>(n)); //same table for every engine
+		std::uniform_real_distribution<double> weight(0.01, 1);
+		for (double& w : weights)
+			w = weight(gen);
+		std::vector<double> intervals(n + 1);
+		std::iota(intervals.begin(), intervals.end(), 0.0);
+
+		timeTable<int>("Discrete", n, [&]() { return std::discrete_distribution<int>(weights.begin(), weights.end()); });
+		timeTable<int>("Discrete (boost alias)", n, [&]() { return boost::random::discrete_distribution<int>(weights.begin(), weights.end()); });
+		timeTable<double>("Piecewise Constant", n, [&]() { return std::piecewise_constant_distribution<double>(intervals.begin(), intervals.end(), weights.begin()); });
+		timeTable<double>("Piecewise Constant (boost)", n, [&]() { return boost::random::piecewise_constant_distribution<double>(intervals.begin(), intervals.end(), weights.begin()); });
+		AliasTableDistribution<int> packed = timeTable<int>("Discrete (Vose packed)", n, [&]() { return AliasTableDistribution<int>(weights.begin(), weights.end()); });
+		std::stringstream note;
+		note << "Table Bytes:\t\t\t" << packed.bytes() << '\n';
+		_extra.back().note += note.str();
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename V, typename B>
+auto EngineTest<T>::timeTable(const std::string& name, std::size_t n, B build) -> decltype(build())
+{
+	const std::string label = name + " n " + std::to_string(n);
+	//small tables are rebuilt until about iterations weights have been processed
+	const int builds = static_cast<int>(std::max<std::size_t>(1, iterations / n));
+	auto dist = build();
+	timeExtra(label + " build", builds, [&]() {
+		for (int b = 0; b < builds; b++)
+			dist = build();
+	});
+	std::stringstream note;
+	note << std::fixed << std::setprecision(2) << "Build ns/Weight:\t\t" << _extra.back().total * 1000000000.0 / builds / n << '\n';
+	_extra.back().note = note.str();
+	timeSweep<V>(label, dist);
+	return dist;
+}
+
+template<typename T>
+void EngineTest<T>::runGeometryTest()
+{
+	std::cout << ">Directions and shapes for: " << _desc << "...";
+	typedef std::array<float, 2> Point2;
+	typedef std::array<float, 3> Point3;
+	//boost returns a freshly allocated std::vector per call
+	timeSweep<std::vector<float>>("Circle (boost uniform_on_sphere)", boost::random::uniform_on_sphere<float>(2));
+	timeSweep<Point2>("Circle (normalize)", UnitCircleDistribution<float, geo::NORMALIZE>(isa));
+	timeSweep<Point2>("Circle (von Neumann)", UnitCircleDistribution<float, geo::REJECTION>(isa));
+	timeSweep<Point2>("Circle (trig)", UnitCircleDistribution<float, geo::TRIG>(isa));
+	timeUnitVectorBatch<2>("Circle (SIMD batch)");
+	timeSweep<std::vector<float>>("Sphere (boost uniform_on_sphere)", boost::random::uniform_on_sphere<float>(3));
+	timeSweep<Point3>("Sphere (normalize)", UnitSphereDistribution<float, geo::NORMALIZE>(isa));
+	timeSweep<Point3>("Sphere (Marsaglia)", UnitSphereDistribution<float, geo::REJECTION>(isa));
+	timeSweep<Point3>("Sphere (trig)", UnitSphereDistribution<float, geo::TRIG>(isa));
+	timeUnitVectorBatch<3>("Sphere (SIMD batch)");
+	timeSweep<Point2>("Disc (rejection)", UnitDiscDistribution<float, geo::REJECTION>(isa));
+	timeSweep<Point2>("Disc (normalize)", UnitDiscDistribution<float, geo::NORMALIZE>(isa));
+	timeSweep<Point2>("Disc (trig)", UnitDiscDistribution<float, geo::TRIG>(isa));
+	timeSweep<Point3>("Cone (30 degrees)", UnitConeDistribution<float>(0.5235988f));
+	timeSweep<Point3>("Triangle", TriangleDistribution<float>(Point3{ { 0, 0, 0 } }, Point3{ { 1, 0, 0 } }, Point3{ { 0, 1, 1 } }));
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<int D>
+void EngineTest<T>::timeUnitVectorBatch(const std::string& name)
+{
+	//level 2 refills a block small enough to stay in L1, level 3 fills vectors of iterations components
+	const int block = level == 3 ? iterations : std::min(iterations, 1024);
+	std::array<std::vector<float>, D> components;
+	float* axis[D];
+	for (int d = 0; d < D; d++)
+	{
+		components[d].resize(block);
+		axis[d] = components[d].data();
+	}
+	UnitVectorBatch<D> batch(isa);
+	timeExtra(name, iterations, [&]() {
+		for (int done = 0; done < iterations; done += block)
+			batch.fill(axis, std::min(block, iterations - done), _eng);
+	});
+}
+
+template<typename T>
+void EngineTest<T>::runShuffleTest()
+{
+	std::cout << ">Shuffles and samples for: " << _desc << "...";
+	//a deck, L1, L2, past the LLC and past any TLB reach, the last is 400MB shuffled at least once whatever iterations
+	//is, so it only runs when iterations is at least the default, past 2^24 elements the batched shuffle gets one index
+	//per word out of its 2^48 product and is slower than std::shuffle
+	const std::size_t sizes[] = { 52, 4096, 262144, 4194304, 100000000 };
+	const std::size_t HUGE_DECK = 100000000;
+	for (std::size_t n : sizes)
+	{
+		if (n == HUGE_DECK && iterations < 1000000)
+			continue;
+		std::vector<std::uint32_t> deck(n);
+		std::iota(deck.begin(), deck.end(), 0);
+		//small arrays are shuffled repeatedly until about iterations elements have moved
+		const int reps = static_cast<int>(std::max<std::size_t>(1, iterations / n));
+		const std::string label = " n " + std::to_string(n);
+		timeExtra("Shuffle" + label, static_cast<long long int>(reps) * n, [&]() {
+			for (int r = 0; r < reps; r++)
+				std::shuffle(deck.begin(), deck.end(), _eng);
+		});
+		timeExtra("Shuffle (batched Fisher-Yates)" + label, static_cast<long long int>(reps) * n, [&]() {
+			for (int r = 0; r < reps; r++)
+				batchedShuffle(deck.begin(), deck.end(), _eng);
+		});
+	}
+
+	const std::size_t population = 1000000;
+	std::vector<std::uint32_t> source(population);
+	std::iota(source.begin(), source.end(), 0);
+	const std::size_t counts[] = { 10, 1000, 100000 };
+	for (std::size_t k : counts)
+	{
+		std::vector<std::uint64_t> chosen(k);
+		std::vector<std::uint32_t> reservoir(k);
+		std::vector<std::uint32_t> deck(population);
+		const int reps = static_cast<int>(std::max<std::size_t>(1, iterations / k));
+		const std::string label = " k " + std::to_string(k) + " of 1M";
+		timeExtra("Sample" + label + " (Floyd)", reps, [&]() {
+			for (int r = 0; r < reps; r++)
+				floydSample(population, k, chosen.begin(), _eng);
+		});
+		//the reservoir streams all n items, so it is only run until about iterations items have passed
+		const int passes = static_cast<int>(std::max<std::size_t>(1, iterations / population));
+		timeExtra("Sample" + label + " (reservoir L)", passes, [&]() {
+			for (int r = 0; r < passes; r++)
+				reservoirSample(source.begin(), source.end(), reservoir.begin(), k, _eng);
+		});
+		//any permutation of the population will do, so the deck is filled once and each pass shuffles on from the last,
+		//k steps a pass like Floyd
+		std::iota(deck.begin(), deck.end(), 0);
+		timeExtra("Sample" + label + " (partial shuffle)", reps, [&]() {
+			for (int r = 0; r < reps; r++)
+				partialShuffle(deck.begin(), deck.end(), k, _eng);
+		});
+	}
+	std::cout << "done!\n";
+}
+
+template<typename T>
+void EngineTest<T>::runApproxTest()
+{
+	std::cout << ">Approximate math for: " << _desc << "...";
+	timeSweep<float>("Normal", std::normal_distribution<float>(0, 1));
+	timeApprox<approx::Normal, approx::Libm>("Normal (block libm)", approx::Normal{ 0, 1 });
+	timeApprox<approx::Normal, approx::Math<7>>("Normal (approx 1e-7)", approx::Normal{ 0, 1 });
+	timeApprox<approx::Normal, approx::Math<4>>("Normal (approx 1e-4)", approx::Normal{ 0, 1 });
+	timeSweep<float>("Lognormal", std::lognormal_distribution<float>(0, 1));
+	timeApprox<approx::Lognormal, approx::Libm>("Lognormal (block libm)", approx::Lognormal{ 0, 1 });
+	timeApprox<approx::Lognormal, approx::Math<7>>("Lognormal (approx 1e-7)", approx::Lognormal{ 0, 1 });
+	timeApprox<approx::Lognormal, approx::Math<4>>("Lognormal (approx 1e-4)", approx::Lognormal{ 0, 1 });
+	//shape 2 so the power is not the identity
+	timeSweep<float>("Weibull", std::weibull_distribution<float>(2, 1));
+	timeApprox<approx::Weibull, approx::Libm>("Weibull (block libm)", approx::Weibull{ 2, 1 });
+	timeApprox<approx::Weibull, approx::Math<7>>("Weibull (approx 1e-7)", approx::Weibull{ 2, 1 });
+	timeApprox<approx::Weibull, approx::Math<4>>("Weibull (approx 1e-4)", approx::Weibull{ 2, 1 });
+	timeSweep<float>("Extreme Value", std::extreme_value_distribution<float>(0, 1));
+	timeApprox<approx::ExtremeValue, approx::Libm>("Extreme Value (block libm)", approx::ExtremeValue{ 0, 1 });
+	timeApprox<approx::ExtremeValue, approx::Math<7>>("Extreme Value (approx 1e-7)", approx::ExtremeValue{ 0, 1 });
+	timeApprox<approx::ExtremeValue, approx::Math<4>>("Extreme Value (approx 1e-4)", approx::ExtremeValue{ 0, 1 });
+	timeSweep<float>("Cauchy", std::cauchy_distribution<float>(0, 1));
+	timeApprox<approx::Cauchy, approx::Libm>("Cauchy (block libm)", approx::Cauchy{ 0, 1 });
+	timeApprox<approx::Cauchy, approx::Math<7>>("Cauchy (approx 1e-7)", approx::Cauchy{ 0, 1 });
+	timeApprox<approx::Cauchy, approx::Math<4>>("Cauchy (approx 1e-4)", approx::Cauchy{ 0, 1 });
+	timeSweep<float>("Exponential", std::exponential_distribution<float>(1));
+	timeApprox<approx::Exponential, approx::Libm>("Exponential (block libm)", approx::Exponential{ 1 });
+	timeApprox<approx::Exponential, approx::Math<7>>("Exponential (approx 1e-7)", approx::Exponential{ 1 });
+	timeApprox<approx::Exponential, approx::Math<4>>("Exponential (approx 1e-4)", approx::Exponential{ 1 });
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename Transform, typename M>
+void EngineTest<T>::timeApprox(const std::string& name, const Transform& transform)
+{
+	timeSweep<float>(name, ApproxDistribution<Transform, M>(transform));
+	//the same uniforms through double libm, error is relative, or absolute where the reference is below 1
+	ApproxDistribution<Transform, M> dist(transform);
+	ApproxDistribution<Transform, approx::Reference> reference(transform);
+	T a = _eng;
+	T b = _eng;
+	const int samples = std::min(iterations, 1 << 20);
+	double worst = 0;
+	for (int i = 0; i < samples; i++)
+	{
+		double r = reference(a);
+		double e = std::fabs(dist(b) - r) / std::max(1.0, std::fabs(r));
+		if (e > worst) //two infinities give NaN, which compares false
+			worst = e;
+	}
+	std::stringstream note;
+	note << std::scientific << std::setprecision(2) << "Max Error:\t\t\t" << worst << '\n';
+	_extra.back().note = note.str();
+}
+
+template<typename T>
+void EngineTest<T>::runMatrixTest()
+{
+	std::cout << ">Sweep matrix for: " << _desc << "...";
+	timeRanges<std::uniform_int_distribution>("Uniform Int range");
+	timeRanges<boost::random::uniform_int_distribution>("Uniform Int (boost) range");
+	timeRanges<LemireIntDistribution>("Uniform Int (Lemire) range");
+
+	timeCell<float>("Uniform Real", "std f", std::uniform_real_distribution<float>(0, 1));
+	timeCell<float>("Uniform Real", "boost f", boost::random::uniform_01<float>());
+	timeCell<float>("Uniform Real", "fast f", FastRealDistribution<float>(0, 1));
+	timeCell<double>("Uniform Real", "std d", std::uniform_real_distribution<double>(0, 1));
+	timeCell<double>("Uniform Real", "boost d", boost::random::uniform_01<double>());
+	timeCell<double>("Uniform Real", "fast d", FastRealDistribution<double>(0, 1));
+
+	//mean and stddev are a multiply and add on a standard normal, only the type changes the cost
+	timeCell<float>("Normal", "std f", std::normal_distribution<float>(0, 1));
+	timeCell<float>("Normal", "boost f", boost::random::normal_distribution<float>(0, 1));
+	timeCell<float>("Normal", "zig f", ZigguratNormalDistribution<float>(0, 1, isa));
+	timeCell<double>("Normal", "std d", std::normal_distribution<double>(0, 1));
+	timeCell<double>("Normal", "boost d", boost::random::normal_distribution<double>(0, 1));
+	timeCell<double>("Normal", "zig d", ZigguratNormalDistribution<double>(0, 1, isa));
+
+	timeCell<bool>("Bernoulli", "std .5", std::bernoulli_distribution(.5));
+	timeCell<bool>("Bernoulli", "std .01", std::bernoulli_distribution(.01));
+	timeCell<bool>("Bernoulli", "thr .5", ThresholdBernoulliDistribution(.5));
+	timeCell<bool>("Bernoulli", "thr .01", ThresholdBernoulliDistribution(.01));
+	timeCell<bool>("Bernoulli", "mask .5", BitmaskBernoulliDistribution(.5));
+	timeCell<bool>("Bernoulli", "mask .01", BitmaskBernoulliDistribution(.01));
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<template<typename> class Dist>
+void EngineTest<T>::timeRanges(const std::string& table)
+{
+	//2^k + 1 is the worst case for rejection, ranges past 2^31 need a wider type and past the engine a second call
+	timeCell<int>(table, "10", Dist<int>(0, 9));
+	timeCell<int>(table, "2^8", Dist<int>(0, 255));
+	timeCell<int>(table, "2^8+1", Dist<int>(0, 256));
+	timeCell<int>(table, "2^16+1", Dist<int>(0, 65536));
+	timeCell<int>(table, "2^31", Dist<int>(0, 2147483647));
+	timeCell<std::int64_t>(table, "2^31+1", Dist<std::int64_t>(0, std::int64_t(1) << 31));
+	timeCell<std::uint32_t>(table, "2^32", Dist<std::uint32_t>(0, 0xFFFFFFFF));
+	timeCell<std::int64_t>(table, "2^32+1", Dist<std::int64_t>(0, std::int64_t(1) << 32));
+	timeCell<std::int64_t>(table, "2^48+1", Dist<std::int64_t>(0, std::int64_t(1) << 48));
+	timeCell<std::uint64_t>(table, "2^64", Dist<std::uint64_t>(0, 0xFFFFFFFFFFFFFFFF));
+}
 
-			else if (clock == 2)
-			{ //clock variant 2
-				switch (x) {  //run test for x
-				case 1:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						intVec[i] = _dist1(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				case 2:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						floatVec[i] = _dist2(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				case 3:
-					_totalTimer.elapsed().clear();
-					_totalTimer.start();
-					for (int i = 0; i < iterations; i++)
-						boolVec[i] = _dist3(_eng);
-					_totalTimer.stop();
-					convertTotalTimer(x);
-					break;
-				}
+template<typename T>
+template<typename V, typename D>
+void EngineTest<T>::timeCell(const std::string& table, const std::string& column, D dist)
+{
+	timeSweep<V>(table + ' ' + column, dist);
+	MatrixCell cell;
+	cell.table = table;
+	cell.column = column;
+	cell.ns = _extra.back().total * 1000000000.0 / _extra.back().count;
+	_matrix.push_back(cell);
+	_extra.pop_back(); //reported by formatMatrix instead
+}
+
+template<typename T>
+void EngineTest<T>::runParamTest()
+{
+	std::cout << ">Per-call parameters for: " << _desc << "...";
+	//a mix of what game code asks for: dice, cards, percentages, container indices and wide rolls
+	const int STREAM = 4096; //a power of two so the stream wraps with a mask
+	const int spans[] = { 5, 51, 99, 999 };
+	std::mt19937 gen(STREAM); //same stream for every engine
+	std::uniform_int_distribution<int> pick(0, 4);
+	std::uniform_int_distribution<int> wide(1, 1000000);
+	std::uniform_int_distribution<int> offset(0, 99);
+	std::uniform_real_distribution<float> centre(-100, 100);
+	std::uniform_real_distribution<float> width(0.01f, 100);
+	std::uniform_real_distribution<float> spread(0.1f, 10);
+	std::uniform_real_distribution<double> chance(0, 1);
+	std::vector<int> lo(STREAM), hi(STREAM);
+	std::vector<float> a(STREAM), b(STREAM), mean(STREAM), stddev(STREAM);
+	std::vector<double> p(STREAM);
+	for (int i = 0; i < STREAM; i++)
+	{
+		int k = pick(gen);
+		lo[i] = offset(gen);
+		hi[i] = lo[i] + (k < 4 ? spans[k] : wide(gen));
+		a[i] = centre(gen);
+		b[i] = a[i] + width(gen);
+		mean[i] = centre(gen);
+		stddev[i] = spread(gen);
+		p[i] = chance(gen);
+	}
+	const int mask = STREAM - 1;
+
+	timeParams<int>(UNIFORM_INT, std::uniform_int_distribution<int>(), [&](int i) { return std::uniform_int_distribution<int>::param_type(lo[i & mask], hi[i & mask]); });
+	timeParams<int>(UNIFORM_INT_BOOST, boost::random::uniform_int_distribution<int>(), [&](int i) { return boost::random::uniform_int_distribution<int>::param_type(lo[i & mask], hi[i & mask]); });
+	timeParams<int>(UNIFORM_INT_LEMIRE, LemireIntDistribution<int>(), [&](int i) { return LemireIntDistribution<int>::param_type(lo[i & mask], hi[i & mask]); });
+	//a new range throws the pooled values away, the worst case for batching
+	timeParams<int>(UNIFORM_INT_POOL, BitPoolIntDistribution<int>(), [&](int i) { return BitPoolIntDistribution<int>::param_type(lo[i & mask], hi[i & mask]); });
+	timeParams<float>(UNIFORM_REAL, std::uniform_real_distribution<float>(), [&](int i) { return std::uniform_real_distribution<float>::param_type(a[i & mask], b[i & mask]); });
+	timeParams<float>(UNIFORM_REAL_FAST, FastRealDistribution<float>(), [&](int i) { return FastRealDistribution<float>::param_type(a[i & mask], b[i & mask]); });
+	timeParams<float>(NORMAL, std::normal_distribution<float>(), [&](int i) { return std::normal_distribution<float>::param_type(mean[i & mask], stddev[i & mask]); });
+	timeParams<float>(NORMAL_BOOST, boost::random::normal_distribution<float>(), [&](int i) { return boost::random::normal_distribution<float>::param_type(mean[i & mask], stddev[i & mask]); });
+	timeParams<bool>(BERNOULLI, std::bernoulli_distribution(), [&](int i) { return std::bernoulli_distribution::param_type(p[i & mask]); });
+	timeParams<bool>(BERNOULLI_THRESHOLD, ThresholdBernoulliDistribution(), [&](int i) { return ThresholdBernoulliDistribution::param_type(p[i & mask]); });
+	//every new p rebuilds the folded word
+	timeParams<bool>(BERNOULLI_BITMASK, BitmaskBernoulliDistribution(), [&](int i) { return BitmaskBernoulliDistribution::param_type(p[i & mask]); });
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<typename V, typename D, typename P>
+void EngineTest<T>::timeParams(int fixed, D dist, P param)
+{
+	const std::string name = _results[fixed].distribution + " per-call param";
+	if (level == 2)
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				dist(_eng, param(i));
+		});
+	else
+	{
+		std::vector<V> vec(iterations);
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				vec[i] = dist(_eng, param(i));
+		});
+	}
+	//clock 1 totals include a timer call per draw, its mean is the per call figure, -t may have run the fixed row
+	//for more calls than iterations
+	const double fixedNs = clock == 1 ? _results[fixed].mean : _results[fixed].total * 1000000000.0 / std::max<long long int>(_results[fixed].count, 1);
+	const double perCallNs = _extra.back().total * 1000000000.0 / iterations;
+	std::stringstream note;
+	note << std::fixed << std::setprecision(2) << "Fixed Param:\t\t\t" << fixedNs << " ns (x" << (fixedNs > 0 ? perCallNs / fixedNs : 0.0) << ")\n";
+	_extra.back().note = note.str();
+}
+
+template<typename T>
+void EngineTest<T>::runScenarioTest()
+{
+	std::cout << ">Scenarios for: " << _desc << "...";
+	for (const Scenario& scenario : scenarios)
+		timeScenario(scenario);
+	std::cout << "done!\n";
+}
+
+template<typename T>
+void EngineTest<T>::timeScenario(const Scenario& scenario)
+{
+	//one std distribution per step, as game code would hold them, kept with the others of its kind
+	std::vector<std::uniform_int_distribution<int>> ints;
+	std::vector<std::uniform_real_distribution<float>> reals;
+	std::vector<std::normal_distribution<float>> normals;
+	std::vector<std::bernoulli_distribution> flips;
+	std::vector<std::exponential_distribution<float>> exponentials;
+	std::vector<std::poisson_distribution<int>> poissons;
+	std::vector<std::discrete_distribution<int>> tables;
+	std::vector<int> kinds;
+	std::vector<std::size_t> slots; //index of each step in the vector of its kind
+	std::vector<double> weights;
+	double total = 0;
+	for (const ScenarioStep& step : scenario.steps)
+	{
+		const std::vector<double>& a = step.args;
+		kinds.push_back(step.kind);
+		switch (step.kind)
+		{
+		case STEP_UNIFORM_INT:
+			slots.push_back(ints.size());
+			ints.push_back(std::uniform_int_distribution<int>(static_cast<int>(a[0]), static_cast<int>(a[1])));
+			break;
+		case STEP_UNIFORM_REAL:
+			slots.push_back(reals.size());
+			reals.push_back(std::uniform_real_distribution<float>(static_cast<float>(a[0]), static_cast<float>(a[1])));
+			break;
+		case STEP_NORMAL:
+			slots.push_back(normals.size());
+			normals.push_back(std::normal_distribution<float>(static_cast<float>(a[0]), static_cast<float>(a[1])));
+			break;
+		case STEP_BERNOULLI:
+			slots.push_back(flips.size());
+			flips.push_back(std::bernoulli_distribution(a[0]));
+			break;
+		case STEP_EXPONENTIAL:
+			slots.push_back(exponentials.size());
+			exponentials.push_back(std::exponential_distribution<float>(static_cast<float>(a[0])));
+			break;
+		case STEP_POISSON:
+			slots.push_back(poissons.size());
+			poissons.push_back(std::poisson_distribution<int>(a[0]));
+			break;
+		default:
+			slots.push_back(tables.size());
+			tables.push_back(std::discrete_distribution<int>(a.begin(), a.end()));
+			break;
+		}
+		weights.push_back(step.weight);
+		total += step.weight;
+	}
 
+	//the order of the steps is drawn once from a fixed seed, so every engine runs the same mix and only its draws are timed
+	//64K steps are too many for a branch predictor to learn and still fit in L2
+	const int SCHEDULE = 65536;
+	const int mask = SCHEDULE - 1;
+	std::vector<std::uint8_t> schedule(SCHEDULE);
+	std::mt19937 gen(SCHEDULE);
+	std::discrete_distribution<int> pick(weights.begin(), weights.end());
+	for (std::uint8_t& s : schedule)
+		s = static_cast<std::uint8_t>(pick(gen));
+	auto draw = [&](int i) -> double {
+		const int s = schedule[i & mask];
+		switch (kinds[s])
+		{
+		case STEP_UNIFORM_INT: return ints[slots[s]](_eng);
+		case STEP_UNIFORM_REAL: return reals[slots[s]](_eng);
+		case STEP_NORMAL: return normals[slots[s]](_eng);
+		case STEP_BERNOULLI: return flips[slots[s]](_eng);
+		case STEP_EXPONENTIAL: return exponentials[slots[s]](_eng);
+		case STEP_POISSON: return poissons[slots[s]](_eng);
+		default: return tables[slots[s]](_eng);
+		}
+	};
+
+	const std::string name = "Scenario " + scenario.name.substr(0, 40);
+	if (level == 2)
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				draw(i);
+		});
+	else
+	{
+		std::vector<double> vec(iterations);
+		timeExtra(name, iterations, [&]() {
+			for (int i = 0; i < iterations; i++)
+				vec[i] = draw(i);
+		});
+	}
+	std::stringstream note;
+	note << std::setprecision(3) << "Mix:\t\t\t\t";
+	for (std::size_t s = 0; s < scenario.steps.size(); s++)
+		note << (s ? ", " : "") << scenario.steps[s].name << ' ' << 100 * scenario.steps[s].weight / total << '%';
+	note << '\n';
+	_extra.back().note = note.str();
+}
+
+template<typename T>
+template<typename V, typename D>
+void EngineTest<T>::timeDistribution(int x, D& dist)
+{
+	if (level == 2)
+		timeLoop(x, [&](int) { dist(_eng); });
+	else if (outputSink == sink::VECTOR)
+	{ //resize before timing so only the assignment is measured
+		std::vector<V> vec(iterations);
+		timeLoop(x, [&](int i) { vec[i] = dist(_eng); });
+	}
+	else
+		timeSink<V>(x, dist);
+}
+
+template<typename T>
+template<typename V, typename D>
+void EngineTest<T>::timeSink(int x, D& dist)
+{
+	typedef typename sink::Stored<V>::type S;
+	sink::Buffer<S> buffer(outputSink, iterations);
+	S* out = buffer.data();
+	if (outputSink == sink::STREAMING)
+	{
+		sink::StreamWriter<S> writer(out);
+		timeLoop(x, [&](int) { writer.put(static_cast<S>(dist(_eng))); });
+		writer.finish();
+	}
+	else if (outputSink == sink::RING)
+	{
+		const std::size_t mask = buffer.ringMask();
+		timeLoop(x, [&](int i) { out[i & mask] = static_cast<S>(dist(_eng)); });
+	}
+	else
+		timeLoop(x, [&](int i) { out[i] = static_cast<S>(dist(_eng)); });
+}
+
+template<typename T>
+template<typename V, typename D>
+void EngineTest<T>::timeBatch(int x, D& dist)
+{
+	if (level == 3 && clock == 2 && outputSink != sink::STREAMING)
+	{ //streaming stores go value by value through timeDistribution, a ring is filled one ring at a time
+		std::vector<V> vec(outputSink == sink::VECTOR ? iterations : 0);
+		sink::Buffer<V> buffer(outputSink, outputSink == sink::VECTOR ? 0 : iterations);
+		V* out = vec.empty() ? buffer.data() : vec.data();
+		const std::size_t chunk = outputSink == sink::RING ? buffer.ringMask() + 1 : iterations;
+		dist.reset(); //no values left over from an earlier run
+		usage::Usage before = usage::sample();
+		_totalTimer.elapsed().clear();
+		_totalTimer.start();
+		for (std::size_t done = 0; done < iterations; done += chunk)
+			dist.fill(out, out + std::min<std::size_t>(chunk, iterations - done), _eng);
+		_totalTimer.stop();
+		_results[x].usage = usage::sample() - before;
+		convertTotalTimer(x);
+	}
+	else
+		timeDistribution<V>(x, dist);
+}
+
+template<typename T>
+template<typename D>
+void EngineTest<T>::noteEngineCalls(int x, D dist)
+{
+	T eng = _eng;
+	CountingEngine<T> counting(eng);
+	for (int i = 0; i < iterations; i++)
+		dist(counting);
+	std::stringstream note;
+	note << std::fixed << std::setprecision(3) << "Engine Calls/Variate:\t\t" << static_cast<double>(counting.calls()) / iterations << '\n'
+		<< std::setprecision(0) << " Variates/Second:\t\t" << (_results[x].total > 0 ? _results[x].count / _results[x].total : 0.0) << '\n';
+	_results[x].note = note.str();
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeLoop(int x, F f)
+{
+	usage::Usage before = usage::sample(); //around the timed loop only, not the setup of the caller
+	if (clock == 1)
+	{ //clock variant 1
+		bool initialized = false;
+		for (int i = 0; i < iterations; i++)
+		{ //run test
+			_timer.elapsed().clear();
+			_timer.start();
+			f(i);
+			_timer.stop();
+			long long int thisIt = _timer.elapsed().wall;
+			if (!initialized)
+			{
+				_results[x].fastest = thisIt;
+				initialized = true;
 			}
+			//keep track of fastest and slowest
+			if (_results[x].fastest > thisIt)
+				_results[x].fastest = thisIt;
+			if (_results[x].slowest < thisIt)
+				_results[x].slowest = thisIt;
+			_results[x].total += thisIt / 1000000000.0; //keep accumulating total time
+		}
+		convertResultsMean(x); //convert total to mean
+	}
+	else if (clock == 2)
+	{ //clock variant 2
+		_totalTimer.elapsed().clear();
+		_totalTimer.start();
+		for (int i = 0; i < iterations; i++)
+			f(i);
+		_totalTimer.stop();
+		convertTotalTimer(x); //convert timer and push to _results array struct
+	}
+	_results[x].usage = usage::sample() - before;
+}
 
-			std::cout << "done!\n";
-		}		
+template<typename T>
+void EngineTest<T>::runInterleaveTest()
+{
+	std::cout << ">Interleaving instances of: " << _desc << "...";
+	std::size_t single = _extra.size(); //first K = 1 row, baseline for the speedup
+	runInterleaved<1>(single);
+	runInterleaved<2>(single);
+	runInterleaved<4>(single);
+	runInterleaved<8>(single);
+	std::cout << "done!\n";
+}
+
+template<typename T>
+template<int K>
+void EngineTest<T>::runInterleaved(std::size_t single)
+{
+	//K is a compile time constant so the inner loop unrolls into K independent dependency chains
+	const int count = iterations - iterations % K;
+	const std::string suffix = " x" + std::to_string(K);
+	std::size_t first = _extra.size();
+
+	switch (level)
+	{
+	case 1:
+		timeExtra("Engine" + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					_ilpEngs[k]();
+		});
+		break;
+	case 2:
+		timeExtra(_results[1].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					_ilpDist1[k](_ilpEngs[k]);
+		});
+		timeExtra(_results[2].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					_ilpDist2[k](_ilpEngs[k]);
+		});
+		timeExtra(_results[3].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					_ilpDist3[k](_ilpEngs[k]);
+		});
 		break;
+	case 3:
+	{
+		std::vector<int> intVec(count);
+		timeExtra(_results[1].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					intVec[i + k] = _ilpDist1[k](_ilpEngs[k]);
+		});
+		std::vector<float> floatVec(count);
+		timeExtra(_results[2].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					floatVec[i + k] = _ilpDist2[k](_ilpEngs[k]);
+		});
+		std::vector<bool> boolVec(count);
+		timeExtra(_results[3].distribution + suffix, count, [&]() {
+			for (int i = 0; i < count; i += K)
+				for (int k = 0; k < K; k++)
+					boolVec[i + k] = _ilpDist3[k](_ilpEngs[k]);
+		});
+		break;
+	}
 	}
+
+	if (K == 1)
+		return;
+	//compare against the matching K = 1 row pushed by runInterleaved<1>
+	for (std::size_t r = 0; first + r < _extra.size(); r++)
+	{
+		const Results& base = _extra[single + r];
+		Results& multi = _extra[first + r];
+		if (multi.total > 0 && multi.count > 0 && base.count > 0) //-i below K leaves no calls to compare
+		{
+			std::stringstream note;
+			note << "Speedup vs x1:\t\t\t" << std::fixed << std::setprecision(2)
+				<< (base.total / base.count) / (multi.total / multi.count) << 'x';
+			multi.note = note.str();
+		}
+	}
+}
+
+template<typename T>
+template<typename F>
+void EngineTest<T>::timeExtra(const std::string& name, long long int count, F f)
+{
+	Results result;
+	result.distribution = name;
+	result.count = count;
+	usage::Usage before = usage::sample();
+	_totalTimer.elapsed().clear();
+	_totalTimer.start();
+	f();
+	_totalTimer.stop();
+	result.usage = usage::sample() - before;
+	result.total = _totalTimer.elapsed().wall / 1000000000.0;
+	result.cpuTotal = (_totalTimer.elapsed().user + _totalTimer.elapsed().system) / 1000000000.0;
+	_extra.push_back(result);
 }
 
 template<typename T>
@@ -0,0 +1,248 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include "distributions.h"
+#include "ziggurat.h"
+
+//gamma family built on Marsaglia and Tsang's squeeze, with normals from the SIMD ziggurat
+//beta, chi-squared, student t and dirichlet are the textbook transforms of gamma draws, so they inherit its speed
+
+
+//gamma(alpha, beta) with beta as scale, Marsaglia and Tsang for alpha >= 1
+//with d = alpha - 1/3 and c = 1 / sqrt(9d), x normal and v = (1 + cx)^3, d * v is accepted by the squeeze u < 1 - 0.0331x^4
+//about 98% of the time without a logarithm, alpha < 1 draws gamma(alpha + 1) and scales it by u^(1 / alpha)
+template<typename RealType = float>
+class FastGammaDistribution
+{
+public:
+	typedef RealType result_type;
+
+	class param_type
+	{
+	public:
+		typedef FastGammaDistribution distribution_type;
+		explicit param_type(RealType alpha = 1, RealType beta = 1) : _alpha(alpha), _beta(beta) {}
+		RealType alpha() const { return _alpha; }
+		RealType beta() const { return _beta; }
+		bool operator==(const param_type& p) const { return _alpha == p._alpha && _beta == p._beta; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		RealType _alpha;
+		RealType _beta;
+	};
+
+	explicit FastGammaDistribution(RealType alpha = 1, RealType beta = 1, int isa = simd::detectIsa()) : _normal(0, 1, isa) { param(param_type(alpha, beta)); }
+	explicit FastGammaDistribution(const param_type& p, int isa = simd::detectIsa()) : _normal(0, 1, isa) { param(p); }
+
+	void reset() { _normal.reset(); }
+	void selectIsa(int isa) { _normal.selectIsa(isa); }
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		_boost = p.alpha() < 1;
+		_d = (_boost ? p.alpha() + 1 : p.alpha()) - RealType(1) / 3;
+		_c = 1 / std::sqrt(9 * _d);
+		_invAlpha = 1 / p.alpha();
+	}
+	RealType alpha() const { return _param.alpha(); }
+	RealType beta() const { return _param.beta(); }
+	result_type min() const { return 0; }
+	result_type max() const { return (std::numeric_limits<RealType>::max)(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		RealType g = standard(eng);
+		if (_boost)
+			g *= std::pow(uniform(eng), _invAlpha);
+		return g * _param.beta();
+	}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng, const param_type& p)
+	{
+		if (p != _param)
+			param(p);
+		return (*this)(eng);
+	}
+
+private:
+	//uniform in (0, 1], keeps the logarithm and the alpha < 1 power finite
+	template<typename Engine>
+	static RealType uniform(Engine& eng) { return 1 - FastRealDistribution<RealType>::canonical(eng); }
+
+	//gamma(d + 1/3, 1)
+	template<typename Engine>
+	RealType standard(Engine& eng)
+	{
+		for (;;)
+		{
+			RealType x, v;
+			do
+			{
+				x = _normal(eng);
+				v = 1 + _c * x;
+			} while (v <= 0);
+			v = v * v * v;
+			RealType u = uniform(eng);
+			RealType x2 = x * x;
+			if (u < 1 - RealType(0.0331) * x2 * x2)
+				return _d * v;
+			if (std::log(u) < RealType(0.5) * x2 + _d * (1 - v + std::log(v)))
+				return _d * v;
+		}
+	}
+
+	param_type _param;
+	ZigguratNormalDistribution<RealType> _normal;
+	bool _boost;
+	RealType _d;
+	RealType _c;
+	RealType _invAlpha;
+
+};
+
+
+//beta(alpha, beta) as x / (x + y) for x gamma(alpha) and y gamma(beta)
+template<typename RealType = float>
+class FastBetaDistribution
+{
+public:
+	typedef RealType result_type;
+
+	class param_type
+	{
+	public:
+		typedef FastBetaDistribution distribution_type;
+		explicit param_type(RealType alpha = 1, RealType beta = 1) : _alpha(alpha), _beta(beta) {}
+		RealType alpha() const { return _alpha; }
+		RealType beta() const { return _beta; }
+		bool operator==(const param_type& p) const { return _alpha == p._alpha && _beta == p._beta; }
+		bool operator!=(const param_type& p) const { return !(*this == p); }
+	private:
+		RealType _alpha;
+		RealType _beta;
+	};
+
+	explicit FastBetaDistribution(RealType alpha = 1, RealType beta = 1, int isa = simd::detectIsa())
+		: _param(alpha, beta), _x(alpha, 1, isa), _y(beta, 1, isa) {}
+	explicit FastBetaDistribution(const param_type& p, int isa = simd::detectIsa())
+		: _param(p), _x(p.alpha(), 1, isa), _y(p.beta(), 1, isa) {}
+
+	void reset() { _x.reset(); _y.reset(); }
+	const param_type& param() const { return _param; }
+	void param(const param_type& p)
+	{
+		_param = p;
+		_x.param(typename FastGammaDistribution<RealType>::param_type(p.alpha(), 1));
+		_y.param(typename FastGammaDistribution<RealType>::param_type(p.beta(), 1));
+	}
+	RealType alpha() const { return _param.alpha(); }
+	RealType beta() const { return _param.beta(); }
+	result_type min() const { return 0; }
+	result_type max() const { return 1; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		RealType x = _x(eng);
+		RealType y = _y(eng);
+		return x / (x + y);
+	}
+
+private:
+	param_type _param;
+	FastGammaDistribution<RealType> _x;
+	FastGammaDistribution<RealType> _y;
+
+};
+
+
+//chi-squared with n degrees of freedom as 2 * gamma(n / 2)
+template<typename RealType = float>
+class FastChiSquaredDistribution
+{
+public:
+	typedef RealType result_type;
+
+	explicit FastChiSquaredDistribution(RealType n = 1, int isa = simd::detectIsa()) : _n(n), _gamma(n / 2, 2, isa) {}
+
+	void reset() { _gamma.reset(); }
+	RealType n() const { return _n; }
+	result_type min() const { return 0; }
+	result_type max() const { return (std::numeric_limits<RealType>::max)(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng) { return _gamma(eng); }
+
+private:
+	RealType _n;
+	FastGammaDistribution<RealType> _gamma;
+
+};
+
+
+//student t with n degrees of freedom as z / sqrt(chi-squared(n) / n)
+template<typename RealType = float>
+class FastStudentTDistribution
+{
+public:
+	typedef RealType result_type;
+
+	explicit FastStudentTDistribution(RealType n = 1, int isa = simd::detectIsa()) : _n(n), _normal(0, 1, isa), _gamma(n / 2, 2 / n, isa) {}
+
+	void reset() { _normal.reset(); _gamma.reset(); }
+	RealType n() const { return _n; }
+	result_type min() const { return -(std::numeric_limits<RealType>::max)(); }
+	result_type max() const { return (std::numeric_limits<RealType>::max)(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng) { return _normal(eng) / std::sqrt(_gamma(eng)); }
+
+private:
+	RealType _n;
+	ZigguratNormalDistribution<RealType> _normal;
+	FastGammaDistribution<RealType> _gamma; //chi-squared(n) / n
+
+};
+
+
+//dirichlet over K components as K gamma(alpha_k) draws divided by their sum
+//Gamma is any gamma distribution constructible from (alpha, beta), so std and boost gammas can be compared in the same loop
+template<typename RealType = float, typename Gamma = FastGammaDistribution<RealType>>
+class DirichletDistribution
+{
+public:
+	typedef RealType result_type;
+
+	//all K components with the same alpha
+	DirichletDistribution(int k, RealType alpha)
+	{
+		for (int i = 0; i < k; i++)
+			_gammas.push_back(Gamma(alpha, 1));
+	}
+
+	int size() const { return static_cast<int>(_gammas.size()); }
+
+	//write the K components of one draw to out
+	template<typename Engine, typename Iter>
+	void operator()(Engine& eng, Iter out)
+	{
+		RealType sum = 0;
+		Iter first = out;
+		for (Gamma& gamma : _gammas)
+		{
+			RealType g = gamma(eng);
+			*out++ = g;
+			sum += g;
+		}
+		RealType scale = 1 / sum;
+		for (; first != out; ++first)
+			*first *= scale;
+	}
+
+private:
+	std::vector<Gamma> _gammas;
+
+};
@@ -0,0 +1,368 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include "distributions.h"
+#include "simd.h"
+#include "ziggurat.h"
+
+//allocation free direction and shape samplers for fixed dimensions, results are std::array
+//directions come in three flavours: normalized normals, rejection from the square (trig free) and the textbook trig forms
+
+namespace geo {
+
+enum method {
+	NORMALIZE, //D normals divided by their length
+	REJECTION, //a point rejected into the unit disc, then mapped without trig
+	TRIG //angles through cos, sin and sqrt
+};
+
+const double TWO_PI = 6.283185307179586;
+
+//uniform in [-1, 1)
+template<typename RealType, typename Engine>
+inline RealType signedUniform(Engine& eng)
+{
+	return 2 * FastRealDistribution<RealType>::canonical(eng) - 1;
+}
+
+//(u, v) uniform in the unit disc, s = u^2 + v^2 in (0, 1), accepts pi / 4 of the pairs
+template<typename RealType, typename Engine>
+inline RealType discPoint(Engine& eng, RealType& u, RealType& v)
+{
+	RealType s;
+	do
+	{
+		u = signedUniform<RealType>(eng);
+		v = signedUniform<RealType>(eng);
+		s = u * u + v * v;
+	} while (s >= 1 || s == 0);
+	return s;
+}
+
+
+//normalize the first n D-dimensional vectors stored as structure of arrays, component d of vector i in axis[d][i]
+//every ISA does the same sum, correctly rounded sqrt and division, the lanes only change how many vectors go at once
+template<int D>
+inline void normalizeRange(float* const* axis, int first, int n)
+{
+	for (int i = first; i < n; i++)
+	{
+		float sum = 0;
+		for (int d = 0; d < D; d++)
+			sum += axis[d][i] * axis[d][i];
+		float inv = 1.0f / std::sqrt(sum);
+		for (int d = 0; d < D; d++)
+			axis[d][i] *= inv;
+	}
+}
+
+template<int D>
+void normalizeScalar(float* const* axis, int n)
+{
+	normalizeRange<D>(axis, 0, n);
+}
+
+#if SIMD_X86
+template<int D>
+SIMD_TARGET("sse2") void normalizeSse2(float* const* axis, int n)
+{
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 v[D];
+		__m128 sum = _mm_setzero_ps();
+		for (int d = 0; d < D; d++)
+		{
+			v[d] = _mm_loadu_ps(axis[d] + i);
+			sum = _mm_add_ps(sum, _mm_mul_ps(v[d], v[d]));
+		}
+		__m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(sum));
+		for (int d = 0; d < D; d++)
+			_mm_storeu_ps(axis[d] + i, _mm_mul_ps(v[d], inv));
+	}
+	normalizeRange<D>(axis, i, n);
+}
+
+template<int D>
+SIMD_TARGET("avx2") void normalizeAvx2(float* const* axis, int n)
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256 v[D];
+		__m256 sum = _mm256_setzero_ps();
+		for (int d = 0; d < D; d++)
+		{
+			v[d] = _mm256_loadu_ps(axis[d] + i);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(v[d], v[d]));
+		}
+		__m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(sum));
+		for (int d = 0; d < D; d++)
+			_mm256_storeu_ps(axis[d] + i, _mm256_mul_ps(v[d], inv));
+	}
+	normalizeRange<D>(axis, i, n);
+}
+
+#if SIMD_AVX512
+template<int D>
+SIMD_TARGET("avx512f") void normalizeAvx512(float* const* axis, int n)
+{
+	int i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		__m512 v[D];
+		__m512 sum = _mm512_setzero_ps();
+		for (int d = 0; d < D; d++)
+		{
+			v[d] = _mm512_loadu_ps(axis[d] + i);
+			sum = _mm512_add_ps(sum, _mm512_mul_ps(v[d], v[d]));
+		}
+		__m512 inv = _mm512_div_ps(_mm512_set1_ps(1.0f), _mm512_sqrt_ps(sum));
+		for (int d = 0; d < D; d++)
+			_mm512_storeu_ps(axis[d] + i, _mm512_mul_ps(v[d], inv));
+	}
+	normalizeRange<D>(axis, i, n);
+}
+#endif
+#endif
+
+}
+
+
+//unit vectors on the circle
+template<typename RealType = float, int Method = geo::REJECTION>
+class UnitCircleDistribution
+{
+public:
+	typedef std::array<RealType, 2> result_type;
+
+	explicit UnitCircleDistribution(int isa = simd::detectIsa()) : _normal(0, 1, isa) {}
+
+	void reset() { _normal.reset(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (Method == geo::NORMALIZE)
+		{
+			RealType x, y, s;
+			do
+			{
+				x = _normal(eng);
+				y = _normal(eng);
+				s = x * x + y * y;
+			} while (s == 0);
+			RealType inv = 1 / std::sqrt(s);
+			return result_type{ { x * inv, y * inv } };
+		}
+		else if (Method == geo::REJECTION)
+		{ //von Neumann, (u^2 - v^2, 2uv) / s is the angle of (u, v) doubled
+			RealType u, v;
+			RealType inv = 1 / geo::discPoint(eng, u, v);
+			return result_type{ { (u * u - v * v) * inv, 2 * u * v * inv } };
+		}
+		else
+		{
+			RealType phi = static_cast<RealType>(geo::TWO_PI) * FastRealDistribution<RealType>::canonical(eng);
+			return result_type{ { std::cos(phi), std::sin(phi) } };
+		}
+	}
+
+private:
+	ZigguratNormalDistribution<RealType> _normal; //only drawn from by NORMALIZE
+
+};
+
+
+//unit vectors on the sphere
+template<typename RealType = float, int Method = geo::REJECTION>
+class UnitSphereDistribution
+{
+public:
+	typedef std::array<RealType, 3> result_type;
+
+	explicit UnitSphereDistribution(int isa = simd::detectIsa()) : _normal(0, 1, isa) {}
+
+	void reset() { _normal.reset(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (Method == geo::NORMALIZE)
+		{
+			RealType x, y, z, s;
+			do
+			{
+				x = _normal(eng);
+				y = _normal(eng);
+				z = _normal(eng);
+				s = x * x + y * y + z * z;
+			} while (s == 0);
+			RealType inv = 1 / std::sqrt(s);
+			return result_type{ { x * inv, y * inv, z * inv } };
+		}
+		else if (Method == geo::REJECTION)
+		{ //Marsaglia 1972, the disc point lifts to the sphere with one sqrt
+			RealType u, v;
+			RealType s = geo::discPoint(eng, u, v);
+			RealType t = 2 * std::sqrt(1 - s);
+			return result_type{ { u * t, v * t, 1 - 2 * s } };
+		}
+		else
+		{ //Archimedes, z uniform in [-1, 1) and a uniform angle around it
+			RealType z = geo::signedUniform<RealType>(eng);
+			RealType phi = static_cast<RealType>(geo::TWO_PI) * FastRealDistribution<RealType>::canonical(eng);
+			RealType r = std::sqrt(1 - z * z);
+			return result_type{ { r * std::cos(phi), r * std::sin(phi), z } };
+		}
+	}
+
+private:
+	ZigguratNormalDistribution<RealType> _normal;
+
+};
+
+
+//points inside the unit disc
+template<typename RealType = float, int Method = geo::REJECTION>
+class UnitDiscDistribution
+{
+public:
+	typedef std::array<RealType, 2> result_type;
+
+	explicit UnitDiscDistribution(int isa = simd::detectIsa()) : _circle(isa) {}
+
+	void reset() { _circle.reset(); }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (Method == geo::REJECTION)
+		{
+			RealType u, v;
+			geo::discPoint(eng, u, v);
+			return result_type{ { u, v } };
+		}
+		//a direction scaled by sqrt(U) so the area, not the radius, is uniform
+		result_type p = _circle(eng);
+		RealType r = std::sqrt(FastRealDistribution<RealType>::canonical(eng));
+		return result_type{ { p[0] * r, p[1] * r } };
+	}
+
+private:
+	UnitCircleDistribution<RealType, Method> _circle; //NORMALIZE and TRIG directions
+
+};
+
+
+//unit vectors within halfAngle radians of +z, z is uniform on [cos(halfAngle), 1] as on the sphere
+//and the direction around the axis comes from the trig free circle
+template<typename RealType = float>
+class UnitConeDistribution
+{
+public:
+	typedef std::array<RealType, 3> result_type;
+
+	explicit UnitConeDistribution(RealType halfAngle = RealType(0.5)) : _halfAngle(halfAngle), _height(1 - std::cos(halfAngle)) {}
+
+	void reset() {}
+	RealType halfAngle() const { return _halfAngle; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		RealType z = 1 - _height * FastRealDistribution<RealType>::canonical(eng);
+		RealType r = std::sqrt(1 - z * z);
+		typename UnitCircleDistribution<RealType>::result_type p = _circle(eng);
+		return result_type{ { p[0] * r, p[1] * r, z } };
+	}
+
+private:
+	RealType _halfAngle;
+	RealType _height; //1 - cos(halfAngle)
+	UnitCircleDistribution<RealType> _circle;
+
+};
+
+
+//points inside the triangle abc, u + v > 1 is folded back across the diagonal so no pair is rejected
+template<typename RealType = float>
+class TriangleDistribution
+{
+public:
+	typedef std::array<RealType, 3> result_type;
+
+	TriangleDistribution(const result_type& a, const result_type& b, const result_type& c) : _a(a)
+	{
+		for (int d = 0; d < 3; d++)
+		{
+			_ab[d] = b[d] - a[d];
+			_ac[d] = c[d] - a[d];
+		}
+	}
+
+	void reset() {}
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		RealType u = FastRealDistribution<RealType>::canonical(eng);
+		RealType v = FastRealDistribution<RealType>::canonical(eng);
+		if (u + v > 1)
+		{
+			u = 1 - u;
+			v = 1 - v;
+		}
+		return result_type{ { _a[0] + u * _ab[0] + v * _ac[0], _a[1] + u * _ab[1] + v * _ac[1], _a[2] + u * _ab[2] + v * _ac[2] } };
+	}
+
+private:
+	result_type _a;
+	result_type _ab;
+	result_type _ac;
+
+};
+
+
+//D-dimensional unit vectors in batches, D blocks of SIMD ziggurat normals normalized in SIMD lanes
+//the output is structure of arrays, component d of vector i goes to axis[d][i]
+template<int D>
+class UnitVectorBatch
+{
+public:
+	typedef void(*Normalize)(float* const*, int);
+
+	explicit UnitVectorBatch(int isa = simd::detectIsa()) : _normal(0, 1, isa) { selectIsa(isa); }
+
+	void selectIsa(int isa)
+	{
+		_normal.selectIsa(isa);
+		_normalize = kernels().select(isa);
+	}
+
+	//a length of exactly 0 needs every component to be 0, under 2^-46 per vector, and is not redrawn
+	template<typename Engine>
+	void fill(float* const* axis, int n, Engine& eng)
+	{
+		for (int d = 0; d < D; d++)
+			_normal.fill(axis[d], axis[d] + n, eng);
+		_normalize(axis, n);
+	}
+
+	static const simd::Dispatch<Normalize>& kernels()
+	{
+#if SIMD_AVX512
+		static const simd::Dispatch<Normalize> table = { { { &geo::normalizeScalar<D>, &geo::normalizeSse2<D>, nullptr, &geo::normalizeAvx2<D>, &geo::normalizeAvx512<D> } } };
+#elif SIMD_X86
+		static const simd::Dispatch<Normalize> table = { { { &geo::normalizeScalar<D>, &geo::normalizeSse2<D>, nullptr, &geo::normalizeAvx2<D>, nullptr } } };
+#else
+		static const simd::Dispatch<Normalize> table = { { { &geo::normalizeScalar<D>, nullptr, nullptr, nullptr, nullptr } } };
+#endif
+		return table;
+	}
+
+private:
+	ZigguratNormalDistribution<float> _normal;
+	Normalize _normalize;
+
+};
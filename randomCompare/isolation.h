@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <thread>
+
+//running a test in a child process of its own, the parent re-runs this program with the hidden -z flag and reads
+//the child's results back from its standard output, the child pins itself to one cpu before it runs
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+
+namespace isolation {
+
+const char* const MARKER = "@results"; //line between the child's progress output and its results
+
+//the cpu children are pinned to, the last one, which usually takes the fewest interrupts
+inline int childCpu()
+{
+	unsigned int cpus = std::thread::hardware_concurrency();
+	return cpus > 1 ? static_cast<int>(cpus - 1) : 0;
+}
+
+//pin the whole process to cpu, false if the system refused
+inline bool pinProcess(int cpu)
+{
+#ifdef _MSC_VER
+	return SetProcessAffinityMask(GetCurrentProcess(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	CPU_SET(cpu, &mask);
+	return sched_setaffinity(0, sizeof mask, &mask) == 0;
+#endif
+}
+
+//run command, copy its output up to MARKER to out and return the rest in data
+//false if the child could not start, never wrote MARKER or exited with an error, e.g. after a crash
+inline bool runChild(const std::string& command, std::FILE* out, std::string& data)
+{
+#ifdef _MSC_VER
+	std::FILE* child = _popen(("\"" + command + "\"").c_str(), "r"); //cmd /c drops the outer quotes
+#else
+	std::FILE* child = popen(command.c_str(), "r");
+#endif
+	if (!child)
+		return false;
+	bool marked = false;
+	std::string line;
+	char buffer[4096];
+	while (std::fgets(buffer, sizeof buffer, child))
+	{
+		if (marked)
+		{
+			data += buffer;
+			continue;
+		}
+		line += buffer;
+		if (line.back() != '\n')
+			continue; //longer than the buffer
+		if (line == std::string(MARKER) + '\n')
+			marked = true;
+		else
+			std::fputs(line.c_str(), out);
+		line.clear();
+		std::fflush(out);
+	}
+	if (!line.empty())
+		std::fputs(line.c_str(), out);
+#ifdef _MSC_VER
+	int status = _pclose(child);
+#else
+	int status = pclose(child);
+#endif
+	return marked && status == 0;
+}
+
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <unordered_set>
+#include "distributions.h"
+
+//permutations and k-of-n selection, everything bounded is drawn with Lemire's multiply shift instead of a modulo
+
+
+//Fisher-Yates with several bounded indices carved from each 64 bit word (Brackett-Bouyer and Lemire's batched shuffle)
+//the bounds i, i - 1, ... of one batch multiply to at most 2^48, x * bound gives each index in the high half and
+//the next x in the low half, and the batch is redrawn when the final x is below 2^64 mod the product, so every index is exact
+//the modulo is only computed when x falls below the product, under 1 in 2^16 words
+template<typename RandomIt, typename Engine>
+void batchedShuffle(RandomIt first, RandomIt last, Engine& eng)
+{
+	const int MAX_BATCH = 6;
+	const std::uint64_t LIMIT = std::uint64_t(1) << 48;
+	std::uint64_t i = static_cast<std::uint64_t>(std::distance(first, last));
+	std::uint64_t index[MAX_BATCH];
+	while (i > 1)
+	{
+		int k = 1;
+		std::uint64_t product = i;
+		while (k < MAX_BATCH && i - k > 1 && product <= LIMIT / (i - k))
+		{
+			product *= i - k;
+			k++;
+		}
+		std::uint64_t x = uniformBits<std::uint64_t>(eng);
+		for (int b = 0; b < k; b++)
+			x = mul128(x, i - b, &index[b]);
+		if (x < product)
+		{
+			const std::uint64_t threshold = (0 - product) % product;
+			while (x < threshold)
+			{
+				x = uniformBits<std::uint64_t>(eng);
+				for (int b = 0; b < k; b++)
+					x = mul128(x, i - b, &index[b]);
+			}
+		}
+		for (int b = 0; b < k; b++, i--)
+			std::iter_swap(first + (i - 1), first + index[b]);
+	}
+}
+
+//uniform index in [0, bound) for a single draw, bound >= 1
+template<typename Engine>
+inline std::uint64_t boundedIndex(std::uint64_t bound, Engine& eng)
+{
+	std::uint64_t index;
+	std::uint64_t x = mul128(uniformBits<std::uint64_t>(eng), bound, &index);
+	if (x < bound)
+	{
+		const std::uint64_t threshold = (0 - bound) % bound;
+		while (x < threshold)
+			x = mul128(uniformBits<std::uint64_t>(eng), bound, &index);
+	}
+	return index;
+}
+
+//k distinct values of [0, n) by Floyd's algorithm, one draw per value and a hash set instead of an array of n
+//for j = n - k .. n - 1, t in [0, j] is taken unless already chosen, then j is, values are written in selection order
+template<typename OutputIt, typename Engine>
+OutputIt floydSample(std::uint64_t n, std::uint64_t k, OutputIt out, Engine& eng)
+{
+	std::unordered_set<std::uint64_t> chosen;
+	chosen.reserve(static_cast<std::size_t>(k));
+	for (std::uint64_t j = n - k; j < n; j++)
+	{
+		std::uint64_t t = boundedIndex(j + 1, eng);
+		if (!chosen.insert(t).second)
+		{
+			t = j;
+			chosen.insert(t);
+		}
+		*out++ = t;
+	}
+	return out;
+}
+
+//k items of [first, last) in one pass by Li's algorithm L, out must hold k items
+//after the reservoir fills, the gap to the next replacement is geometric, so only O(k log(n / k)) items are drawn for
+//returns the number of items written, less than k when the input is shorter
+template<typename InputIt, typename RandomIt, typename Engine>
+std::size_t reservoirSample(InputIt first, InputIt last, RandomIt out, std::size_t k, Engine& eng)
+{
+	std::size_t filled = 0;
+	for (; first != last && filled < k; ++first)
+		out[filled++] = *first;
+	if (filled < k)
+		return filled;
+	double w = std::exp(std::log(1 - FastRealDistribution<double>::canonical(eng)) / k);
+	for (;;)
+	{
+		double skip = std::floor(std::log(1 - FastRealDistribution<double>::canonical(eng)) / std::log(1 - w));
+		for (double s = 0; s < skip && first != last; s++) //skip items without drawing for them
+			++first;
+		if (first == last)
+			return k;
+		out[static_cast<std::size_t>(boundedIndex(k, eng))] = *first;
+		++first;
+		w *= std::exp(std::log(1 - FastRealDistribution<double>::canonical(eng)) / k);
+	}
+}
+
+//k of [first, last) by the first k steps of Fisher-Yates, the selection ends up in [last - k, last)
+template<typename RandomIt, typename Engine>
+void partialShuffle(RandomIt first, RandomIt last, std::size_t k, Engine& eng)
+{
+	std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+	std::uint64_t i = n;
+	for (; i > n - k; i--)
+		std::iter_swap(first + (i - 1), first + boundedIndex(i, eng));
+}
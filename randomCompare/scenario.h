@@ -0,0 +1,170 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost\property_tree\ptree.hpp>
+#include <boost\property_tree\ini_parser.hpp>
+
+//weighted mixes of distributions read from an INI file, one section per scenario and one key per step
+//a step is its kind, its weight and then the kind's parameters, weights are relative within a scenario:
+//
+//	[gameplay]
+//	dice = uniform_int 50 1 6
+//	hit = uniform_real 30 0 1
+//	spread = normal 15 0 2.5
+//	loot = discrete 5 60 25 10 4 1
+
+enum stepKinds {
+	STEP_UNIFORM_INT, //a b
+	STEP_UNIFORM_REAL, //a b
+	STEP_NORMAL, //mean stddev
+	STEP_BERNOULLI, //p
+	STEP_EXPONENTIAL, //lambda
+	STEP_POISSON, //mean
+	STEP_DISCRETE, //one or more weights
+	STEP_KIND_COUNT
+
+};
+
+struct ScenarioStep
+{
+	std::string name = "";
+	int kind = STEP_UNIFORM_INT;
+	double weight = 0;
+	std::vector<double> args;
+
+};
+
+struct Scenario
+{
+	std::string name = "";
+	std::vector<ScenarioStep> steps;
+
+};
+
+const int MAX_STEPS = 255; //steps are scheduled as bytes
+
+inline int stepKind(const std::string& s)
+{
+	const char* names[STEP_KIND_COUNT] = { "uniform_int", "uniform_real", "normal", "bernoulli", "exponential", "poisson", "discrete" };
+	for (int k = 0; k < STEP_KIND_COUNT; k++)
+		if (s == names[k])
+			return k;
+	return -1;
+}
+
+//check the parameters of step so the distributions built from it are well defined, false with a message in error if not
+inline bool checkStep(const ScenarioStep& step, std::string& error)
+{
+	const std::vector<double>& a = step.args;
+	bool ok;
+	switch (step.kind)
+	{
+	case STEP_UNIFORM_INT:
+		ok = a.size() == 2 && a[0] <= a[1] && std::floor(a[0]) == a[0] && std::floor(a[1]) == a[1]
+			&& a[0] >= (std::numeric_limits<int>::min)() && a[1] <= (std::numeric_limits<int>::max)();
+		break;
+	case STEP_UNIFORM_REAL:
+		ok = a.size() == 2 && a[0] < a[1];
+		break;
+	case STEP_NORMAL:
+		ok = a.size() == 2 && a[1] > 0;
+		break;
+	case STEP_BERNOULLI:
+		ok = a.size() == 1 && a[0] >= 0 && a[0] <= 1;
+		break;
+	case STEP_EXPONENTIAL:
+	case STEP_POISSON:
+		ok = a.size() == 1 && a[0] > 0;
+		break;
+	default: //STEP_DISCRETE
+	{
+		double sum = 0;
+		ok = !a.empty();
+		for (double w : a)
+		{
+			ok = ok && w >= 0;
+			sum += w;
+		}
+		ok = ok && sum > 0;
+		break;
+	}
+	}
+	if (!ok)
+		error = "bad parameters for step '" + step.name + "'";
+	return ok;
+}
+
+//read every scenario in file, false with a message in error when the file cannot be used
+inline bool loadScenarios(const std::string& file, std::vector<Scenario>& scenarios, std::string& error)
+{
+	boost::property_tree::ptree tree;
+	try
+	{
+		boost::property_tree::ini_parser::read_ini(file, tree);
+	}
+	catch (const boost::property_tree::ini_parser_error& e)
+	{
+		error = e.what();
+		return false;
+	}
+	for (const boost::property_tree::ptree::value_type& section : tree)
+	{
+		if (!section.second.data().empty())
+		{ //a key before the first section
+			error = "step '" + section.first + "' is not in a [scenario] section";
+			return false;
+		}
+		Scenario scenario;
+		scenario.name = section.first;
+		for (const boost::property_tree::ptree::value_type& key : section.second)
+		{
+			ScenarioStep step;
+			step.name = key.first;
+			std::istringstream in(key.second.data());
+			std::string kind;
+			in >> kind;
+			step.kind = stepKind(kind);
+			if (step.kind < 0)
+			{
+				error = "unknown kind '" + kind + "' for step '" + step.name + "'";
+				return false;
+			}
+			if (!(in >> step.weight) || step.weight <= 0)
+			{
+				error = "missing or non-positive weight for step '" + step.name + "'";
+				return false;
+			}
+			double value;
+			while (in >> value)
+				step.args.push_back(value);
+			if (!in.eof())
+			{
+				error = "bad parameters for step '" + step.name + "'";
+				return false;
+			}
+			if (!checkStep(step, error))
+				return false;
+			scenario.steps.push_back(step);
+		}
+		if (scenario.steps.empty())
+		{
+			error = "no steps in scenario '" + scenario.name + "'";
+			return false;
+		}
+		if (scenario.steps.size() > MAX_STEPS)
+		{
+			error = "more than 255 steps in scenario '" + scenario.name + "'";
+			return false;
+		}
+		scenarios.push_back(scenario);
+	}
+	if (scenarios.empty())
+	{
+		error = "no scenarios in " + file;
+		return false;
+	}
+	return true;
+}
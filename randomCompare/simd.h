@@ -0,0 +1,306 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//x86 targets get cpuid detection and intrinsic kernels, everything else runs the scalar kernels
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#ifndef _MSC_VER
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+//AVX-512 intrinsics arrived with Visual Studio 2017 15.3, older toolsets fall back to AVX2
+#if SIMD_X86 && (!defined(_MSC_VER) || _MSC_VER >= 1911)
+#define SIMD_AVX512 1
+#else
+#define SIMD_AVX512 0
+#endif
+
+//msvc allows any intrinsic in any function, gcc and clang need the target named per function
+#ifdef _MSC_VER
+#define SIMD_TARGET(isa)
+#else
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+
+namespace simd {
+
+//instruction sets kernels are compiled for, ordered so a higher value implies the lower ones
+enum isa {
+	ISA_SCALAR,
+	ISA_SSE2,
+	ISA_SSE41,
+	ISA_AVX2,
+	ISA_AVX512,
+	ISA_COUNT
+
+};
+
+inline const std::string& isaName(int i)
+{
+	static const std::array<std::string, ISA_COUNT> names = { { "Scalar", "SSE2", "SSE4.1", "AVX2", "AVX-512" } };
+	return names[i];
+}
+
+#if SIMD_X86
+inline void cpuid(int info[4], int leaf, int subleaf)
+{
+#ifdef _MSC_VER
+	__cpuidex(info, leaf, subleaf);
+#else
+	unsigned int a = 0, b = 0, c = 0, d = 0;
+	__cpuid_count(leaf, subleaf, a, b, c, d);
+	info[0] = a; info[1] = b; info[2] = c; info[3] = d;
+#endif
+}
+
+//extended control register 0, tells which register files the OS saves on context switch
+inline unsigned long long xgetbv()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int lo = 0, hi = 0;
+	__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+//highest ISA supported by both the CPU and the OS, detected once
+inline int detectIsa()
+{
+	static const int detected = []() {
+		int best = ISA_SCALAR;
+#if SIMD_X86
+		int info[4];
+		cpuid(info, 0, 0);
+		int maxLeaf = info[0];
+		cpuid(info, 1, 0);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool sse41 = (info[2] & (1 << 19)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		unsigned long long xcr0 = osxsave ? xgetbv() : 0;
+		bool ymm = avx && (xcr0 & 0x6) == 0x6; //xmm and ymm state
+		bool zmm = ymm && (xcr0 & 0xe0) == 0xe0; //opmask and zmm state
+		bool avx2 = false;
+		bool avx512 = false;
+		if (maxLeaf >= 7)
+		{
+			cpuid(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+			avx512 = (info[1] & (1 << 16)) != 0; //AVX-512 Foundation
+		}
+		if (sse2)
+			best = ISA_SSE2;
+		if (sse2 && sse41)
+			best = ISA_SSE41;
+		if (best == ISA_SSE41 && ymm && avx2)
+			best = ISA_AVX2;
+		if (best == ISA_AVX2 && zmm && avx512)
+			best = ISA_AVX512;
+#endif
+		return best;
+	}();
+	return detected;
+}
+
+//index of the lowest set bit of a non zero mask, used to walk movemask results
+inline int lowestBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+//kernel table, one entry per ISA, nullptr where the kernel was not compiled for that target
+template<typename Fn>
+struct Dispatch
+{
+	std::array<Fn, ISA_COUNT> impl;
+
+	//best implementation at or below i, the scalar entry must always be set
+	Fn select(int i) const
+	{
+		while (i > ISA_SCALAR && impl[i] == nullptr)
+			i--;
+		return impl[i];
+	}
+
+	//ISA the selected implementation was actually compiled for
+	int resolve(int i) const
+	{
+		while (i > ISA_SCALAR && impl[i] == nullptr)
+			i--;
+		return i;
+	}
+};
+
+
+//multiplicative LCG modulo 2^31 - 1 (minstd_rand, minstd_rand0) in 16 lanes
+//out is lane interleaved, out[j * 16 + l] is output j of lane l
+//(x * A) mod M is folded as (p & M) + (p >> 31) twice, the second fold never reaches M since x is never 0 mod M
+const int LCG_LANES = 16;
+const std::uint32_t LCG_MODULUS = 2147483647u;
+
+template<std::uint32_t A>
+void lcgFillScalar(std::uint32_t* state, std::uint32_t* out, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i += LCG_LANES)
+		for (int l = 0; l < LCG_LANES; l++)
+		{
+			std::uint64_t p = static_cast<std::uint64_t>(state[l]) * A;
+			std::uint32_t r = static_cast<std::uint32_t>((p & LCG_MODULUS) + (p >> 31));
+			r = (r & LCG_MODULUS) + (r >> 31);
+			state[l] = r;
+			out[i + l] = r;
+		}
+}
+
+#if SIMD_X86
+template<std::uint32_t A>
+SIMD_TARGET("sse2") void lcgFillSse2(std::uint32_t* state, std::uint32_t* out, std::size_t n)
+{
+	const __m128i a = _mm_set1_epi32(A);
+	const __m128i m64 = _mm_set1_epi64x(LCG_MODULUS);
+	const __m128i m32 = _mm_set1_epi32(LCG_MODULUS);
+	__m128i x[4];
+	for (int v = 0; v < 4; v++)
+		x[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state) + v);
+	for (std::size_t i = 0; i < n; i += LCG_LANES)
+		for (int v = 0; v < 4; v++)
+		{ //even lanes in the low halves, odd lanes shifted down into them
+			__m128i pe = _mm_mul_epu32(x[v], a);
+			__m128i po = _mm_mul_epu32(_mm_srli_epi64(x[v], 32), a);
+			pe = _mm_add_epi64(_mm_and_si128(pe, m64), _mm_srli_epi64(pe, 31));
+			po = _mm_add_epi64(_mm_and_si128(po, m64), _mm_srli_epi64(po, 31));
+			__m128i r = _mm_or_si128(pe, _mm_slli_epi64(po, 32));
+			x[v] = _mm_add_epi32(_mm_and_si128(r, m32), _mm_srli_epi32(r, 31));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i) + v, x[v]);
+		}
+	for (int v = 0; v < 4; v++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state) + v, x[v]);
+}
+
+template<std::uint32_t A>
+SIMD_TARGET("sse4.1") void lcgFillSse41(std::uint32_t* state, std::uint32_t* out, std::size_t n)
+{
+	const __m128i a = _mm_set1_epi32(A);
+	const __m128i m64 = _mm_set1_epi64x(LCG_MODULUS);
+	const __m128i m32 = _mm_set1_epi32(LCG_MODULUS);
+	__m128i x[4];
+	for (int v = 0; v < 4; v++)
+		x[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state) + v);
+	for (std::size_t i = 0; i < n; i += LCG_LANES)
+		for (int v = 0; v < 4; v++)
+		{ //same as sse2 but recombines the halves with a blend
+			__m128i pe = _mm_mul_epu32(x[v], a);
+			__m128i po = _mm_mul_epu32(_mm_srli_epi64(x[v], 32), a);
+			pe = _mm_add_epi64(_mm_and_si128(pe, m64), _mm_srli_epi64(pe, 31));
+			po = _mm_add_epi64(_mm_and_si128(po, m64), _mm_srli_epi64(po, 31));
+			__m128i r = _mm_blend_epi16(pe, _mm_slli_epi64(po, 32), 0xCC);
+			x[v] = _mm_add_epi32(_mm_and_si128(r, m32), _mm_srli_epi32(r, 31));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i) + v, x[v]);
+		}
+	for (int v = 0; v < 4; v++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state) + v, x[v]);
+}
+
+template<std::uint32_t A>
+SIMD_TARGET("avx2") void lcgFillAvx2(std::uint32_t* state, std::uint32_t* out, std::size_t n)
+{
+	const __m256i a = _mm256_set1_epi32(A);
+	const __m256i m64 = _mm256_set1_epi64x(LCG_MODULUS);
+	const __m256i m32 = _mm256_set1_epi32(LCG_MODULUS);
+	__m256i x[2];
+	for (int v = 0; v < 2; v++)
+		x[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state) + v);
+	for (std::size_t i = 0; i < n; i += LCG_LANES)
+		for (int v = 0; v < 2; v++)
+		{
+			__m256i pe = _mm256_mul_epu32(x[v], a);
+			__m256i po = _mm256_mul_epu32(_mm256_srli_epi64(x[v], 32), a);
+			pe = _mm256_add_epi64(_mm256_and_si256(pe, m64), _mm256_srli_epi64(pe, 31));
+			po = _mm256_add_epi64(_mm256_and_si256(po, m64), _mm256_srli_epi64(po, 31));
+			__m256i r = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xAA);
+			x[v] = _mm256_add_epi32(_mm256_and_si256(r, m32), _mm256_srli_epi32(r, 31));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i) + v, x[v]);
+		}
+	for (int v = 0; v < 2; v++)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(state) + v, x[v]);
+}
+
+#if SIMD_AVX512
+template<std::uint32_t A>
+SIMD_TARGET("avx512f") void lcgFillAvx512(std::uint32_t* state, std::uint32_t* out, std::size_t n)
+{
+	const __m512i a = _mm512_set1_epi32(A);
+	const __m512i m64 = _mm512_set1_epi64(LCG_MODULUS);
+	const __m512i m32 = _mm512_set1_epi32(LCG_MODULUS);
+	__m512i x = _mm512_loadu_si512(state);
+	for (std::size_t i = 0; i < n; i += LCG_LANES)
+	{
+		__m512i pe = _mm512_mul_epu32(x, a);
+		__m512i po = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), a);
+		pe = _mm512_add_epi64(_mm512_and_si512(pe, m64), _mm512_srli_epi64(pe, 31));
+		po = _mm512_add_epi64(_mm512_and_si512(po, m64), _mm512_srli_epi64(po, 31));
+		__m512i r = _mm512_mask_blend_epi32(0xAAAA, pe, _mm512_slli_epi64(po, 32));
+		x = _mm512_add_epi32(_mm512_and_si512(r, m32), _mm512_srli_epi32(r, 31));
+		_mm512_storeu_si512(out + i, x);
+	}
+	_mm512_storeu_si512(state, x);
+}
+#endif
+#endif
+
+template<std::uint32_t A>
+class LcgLanes
+{
+public:
+	typedef void(*Fill)(std::uint32_t*, std::uint32_t*, std::size_t);
+
+	//lane l starts from seed l + 1, so it matches a scalar engine seeded the same way
+	explicit LcgLanes(int isa)
+	{
+		for (int l = 0; l < LCG_LANES; l++)
+			_state[l] = l + 1;
+		_fill = kernels().select(isa);
+	}
+
+	//n must be a multiple of LCG_LANES
+	void fill(std::uint32_t* out, std::size_t n) { _fill(_state.data(), out, n); }
+
+	static const Dispatch<Fill>& kernels()
+	{
+#if SIMD_AVX512
+		static const Dispatch<Fill> table = { { { &lcgFillScalar<A>, &lcgFillSse2<A>, &lcgFillSse41<A>, &lcgFillAvx2<A>, &lcgFillAvx512<A> } } };
+#elif SIMD_X86
+		static const Dispatch<Fill> table = { { { &lcgFillScalar<A>, &lcgFillSse2<A>, &lcgFillSse41<A>, &lcgFillAvx2<A>, nullptr } } };
+#else
+		static const Dispatch<Fill> table = { { { &lcgFillScalar<A>, nullptr, nullptr, nullptr, nullptr } } };
+#endif
+		return table;
+	}
+
+private:
+	std::array<std::uint32_t, LCG_LANES> _state;
+	Fill _fill;
+
+};
+
+}
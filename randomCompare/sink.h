@@ -0,0 +1,216 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "simd.h"
+
+//where level 3 writes its variates, a std::vector as always, or memory that separates the cost of generating from
+//the cost of the memory system: bools as bytes, pages faulted in before timing, pages first touched while timing,
+//streaming stores that bypass the cache, huge pages, or a ring small enough to stay in L1
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+
+namespace sink {
+
+enum kinds {
+	VECTOR, //std::vector<V>, zero filled before timing, bools packed as bits
+	BYTES, //std::vector with bools as bytes
+	PREFAULTED, //fresh pages written once before timing
+	FIRST_TOUCH, //fresh pages never touched, each first store of a page faults inside the timing
+	STREAMING, //prefaulted pages filled with non-temporal stores a cache line at a time
+	HUGE_PAGES, //prefaulted huge pages, falling back to normal pages
+	RING, //RING_BYTES reused round robin
+	KIND_COUNT
+
+};
+
+inline const std::string& kindName(int k)
+{
+	static const std::string names[KIND_COUNT] = { "vector", "byte vector", "prefaulted", "first touch", "streaming stores", "huge pages", "L1 ring" };
+	return names[k];
+}
+
+const std::size_t LINE = 64;
+const std::size_t RING_BYTES = 16 << 10; //half the smallest L1 data cache in use
+const std::size_t HUGE_PAGE = 2 << 20;
+
+//the type a sink stores for V, bool as a byte so a store is a plain store and not a read-modify-write of a bit
+template<typename V>
+struct Stored { typedef V type; };
+
+template<>
+struct Stored<bool> { typedef unsigned char type; };
+
+enum hugeStates {
+	HUGE_UNKNOWN, //none asked for yet
+	HUGE_EXPLICIT, //reserved huge pages, MAP_HUGETLB or MEM_LARGE_PAGES
+	HUGE_TRANSPARENT, //normal pages marked for transparent huge pages
+	HUGE_UNAVAILABLE //normal pages
+
+};
+
+//what the last request for huge pages got
+inline int& hugeState()
+{
+	static int state = HUGE_UNKNOWN;
+	return state;
+}
+
+//memory straight from the operating system, so its pages are fresh rather than recycled by the heap
+class Pages
+{
+public:
+	Pages(std::size_t bytes, bool huge, bool prefault) : _data(nullptr), _bytes(bytes)
+	{
+		if (bytes == 0)
+			return;
+#ifdef _MSC_VER
+		if (huge && GetLargePageMinimum() > 0)
+		{ //needs the lock pages in memory privilege, which accounts rarely have
+			SIZE_T large = GetLargePageMinimum();
+			_bytes = (bytes + large - 1) / large * large;
+			_data = VirtualAlloc(nullptr, _bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			hugeState() = _data ? HUGE_EXPLICIT : HUGE_UNAVAILABLE;
+		}
+		else if (huge)
+			hugeState() = HUGE_UNAVAILABLE; //no large page support at all
+		if (!_data)
+		{
+			_bytes = bytes;
+			_data = VirtualAlloc(nullptr, _bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		}
+#else
+		if (huge)
+		{ //reserved pages first, then transparent huge pages on an aligned length
+			_bytes = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+#ifdef MAP_HUGETLB
+			_data = mmap(nullptr, _bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (_data == MAP_FAILED)
+				_data = nullptr;
+#endif
+			hugeState() = _data ? HUGE_EXPLICIT : HUGE_UNAVAILABLE;
+		}
+		if (!_data)
+		{
+			_data = mmap(nullptr, _bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (_data == MAP_FAILED)
+				_data = nullptr;
+#ifdef MADV_HUGEPAGE
+			if (huge && _data && madvise(_data, _bytes, MADV_HUGEPAGE) == 0)
+				hugeState() = HUGE_TRANSPARENT;
+#endif
+		}
+#endif
+		if (!_data)
+			throw std::bad_alloc();
+		if (prefault)
+			std::memset(_data, 0, _bytes);
+	}
+
+	~Pages()
+	{
+		if (!_data)
+			return;
+#ifdef _MSC_VER
+		VirtualFree(_data, 0, MEM_RELEASE);
+#else
+		munmap(_data, _bytes);
+#endif
+	}
+
+	Pages(const Pages&) = delete;
+	Pages& operator=(const Pages&) = delete;
+
+	void* data() { return _data; }
+
+private:
+	void* _data;
+	std::size_t _bytes;
+
+};
+
+//the memory of a sink of count values of S, a ring has RING_BYTES whatever count is
+template<typename S>
+class Buffer
+{
+public:
+	Buffer(int kind, std::size_t count)
+		: _pages(kind == BYTES || kind == RING ? 0 : count * sizeof(S), kind == HUGE_PAGES, kind != FIRST_TOUCH),
+		_vector(kind == RING ? RING_BYTES / sizeof(S) : kind == BYTES ? count : 0) {}
+
+	S* data() { return _vector.empty() ? static_cast<S*>(_pages.data()) : _vector.data(); }
+	std::size_t ringMask() const { return _vector.size() - 1; } //for RING only, its size is a power of 2
+
+private:
+	Pages _pages;
+	std::vector<S> _vector;
+
+};
+
+//values of S gathered into a cache line and written past the cache with non-temporal stores, out must be 16 byte
+//aligned, targets without SSE2 copy the line normally
+template<typename S>
+class StreamWriter
+{
+public:
+	explicit StreamWriter(void* out) : _out(static_cast<unsigned char*>(out)), _used(0)
+	{
+		static_assert(LINE % sizeof(S) == 0, "values must tile a cache line");
+	}
+
+	void put(const S& v)
+	{
+		std::memcpy(_line + _used, &v, sizeof v);
+		_used += sizeof v;
+		if (_used == LINE)
+		{
+			store();
+			_out += LINE;
+			_used = 0;
+		}
+	}
+
+	//write what is left of the last line and order the streamed stores before anything after
+	void finish()
+	{
+		std::memcpy(_out, _line, _used);
+		_used = 0;
+#if SIMD_X86
+		fence();
+#endif
+	}
+
+private:
+#if SIMD_X86
+	SIMD_TARGET("sse2")
+	void store()
+	{
+		for (std::size_t k = 0; k < LINE; k += 16)
+			_mm_stream_si128(reinterpret_cast<__m128i*>(_out + k), _mm_load_si128(reinterpret_cast<const __m128i*>(_line + k)));
+	}
+
+	SIMD_TARGET("sse2")
+	static void fence() { _mm_sfence(); }
+#else
+	void store() { std::memcpy(_out, _line, LINE); }
+#endif
+
+	unsigned char* _out;
+	std::size_t _used;
+	alignas(16) unsigned char _line[LINE];
+
+};
+
+}
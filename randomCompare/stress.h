@@ -0,0 +1,191 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+//background load for timing an engine the way it runs on a busy host, stressor threads are pinned to cpus 1, 2, ...
+//while the measuring thread holds cpu 0, on most windows systems cpu 1 is the hyperthread sibling of cpu 0, on linux
+//the sibling is usually cpu 0 + the number of cores, so -y past the core count reaches it
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+
+namespace stress {
+
+enum kinds {
+	QUIET, //no stressors, the baseline
+	CACHE, //random writes over a buffer larger than the last level cache
+	BANDWIDTH, //streaming copy between two large buffers
+	BRANCH, //data dependent branches and an indirect jump on random bits
+	KIND_COUNT
+
+};
+
+inline const std::string& kindName(int k)
+{
+	static const std::string names[KIND_COUNT] = { "Quiet", "Cache Thrash", "Memory Stream", "Branch Heavy" };
+	return names[k];
+}
+
+const std::size_t CACHE_BYTES = 32 << 20;
+const std::size_t STREAM_BYTES = 64 << 20; //per buffer, two per thread
+const int BLOCK = 64; //calls timed together, enough to hide the clock
+const int BLOCKS = 4096; //blocks per row, the p99 is the 41st slowest
+
+//cpu of stressor i, skipping cpu 0 when there is any other
+inline int stressorCpu(int i)
+{
+	unsigned int cpus = std::thread::hardware_concurrency();
+	return cpus > 1 ? 1 + i % static_cast<int>(cpus - 1) : 0;
+}
+
+//keep the calling thread on cpu until destroyed, then give it back the cpus it had
+class Pin
+{
+public:
+	explicit Pin(int cpu)
+	{
+#ifdef _MSC_VER
+		_previous = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu);
+#else
+		_saved = sched_getaffinity(0, sizeof _previous, &_previous) == 0;
+		cpu_set_t mask;
+		CPU_ZERO(&mask);
+		CPU_SET(cpu, &mask);
+		sched_setaffinity(0, sizeof mask, &mask);
+#endif
+	}
+
+	~Pin()
+	{
+#ifdef _MSC_VER
+		if (_previous)
+			SetThreadAffinityMask(GetCurrentThread(), _previous);
+#else
+		if (_saved)
+			sched_setaffinity(0, sizeof _previous, &_previous);
+#endif
+	}
+
+	Pin(const Pin&) = delete;
+	Pin& operator=(const Pin&) = delete;
+
+private:
+#ifdef _MSC_VER
+	DWORD_PTR _previous;
+#else
+	bool _saved;
+	cpu_set_t _previous;
+#endif
+
+};
+
+//threads running one kind of load until destroyed, the constructor returns once they had time to fill their buffers
+class Stressors
+{
+public:
+	Stressors(int kind, int threads) : _stop(false)
+	{
+		if (kind == QUIET)
+			return;
+		for (int i = 0; i < threads; i++)
+			_threads.emplace_back(&Stressors::run, kind, stressorCpu(i), std::ref(_stop));
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+
+	~Stressors()
+	{
+		_stop.store(true, std::memory_order_relaxed);
+		for (std::thread& t : _threads)
+			t.join();
+	}
+
+	Stressors(const Stressors&) = delete;
+	Stressors& operator=(const Stressors&) = delete;
+
+private:
+	static void run(int kind, int cpu, std::atomic<bool>& stop)
+	{
+		Pin pin(cpu);
+		std::uint64_t x = 0x9E3779B97F4A7C15ULL + cpu; //xorshift state, distinct per thread
+		switch (kind)
+		{
+		case CACHE:
+		{
+			std::vector<std::uint64_t> buffer(CACHE_BYTES / sizeof(std::uint64_t));
+			const std::size_t lines = CACHE_BYTES / 64;
+			while (!stop.load(std::memory_order_relaxed))
+				for (int i = 0; i < 4096; i++)
+				{
+					x ^= x << 13;
+					x ^= x >> 7;
+					x ^= x << 17;
+					buffer[(x % lines) * 8]++;
+				}
+			break;
+		}
+		case BANDWIDTH:
+		{
+			std::vector<std::uint64_t> from(STREAM_BYTES / sizeof(std::uint64_t), 1);
+			std::vector<std::uint64_t> to(from.size());
+			const std::size_t chunk = 1 << 16;
+			while (!stop.load(std::memory_order_relaxed))
+				for (std::size_t first = 0; first < from.size() && !stop.load(std::memory_order_relaxed); first += chunk)
+					for (std::size_t i = first; i < first + chunk; i++)
+						to[i] = from[i] + 1;
+			break;
+		}
+		default: //BRANCH
+		{
+			static std::atomic<std::uint64_t> sink(0); //keeps the loop from being optimized away
+			std::uint64_t acc = 0;
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				for (int i = 0; i < 4096; i++)
+				{
+					x ^= x << 13;
+					x ^= x >> 7;
+					x ^= x << 17;
+					if (x & 1)
+						acc += x >> 3;
+					else
+						acc ^= x << 5;
+					switch (x >> 61)
+					{
+					case 0: acc += 1; break;
+					case 1: acc *= 3; break;
+					case 2: acc ^= 0xFF; break;
+					case 3: acc -= x; break;
+					case 4: acc += acc >> 7; break;
+					case 5: acc = ~acc; break;
+					case 6: acc <<= 1; break;
+					default: acc >>= 1; break;
+					}
+				}
+				sink.store(acc, std::memory_order_relaxed);
+			}
+			break;
+		}
+		}
+	}
+
+	std::atomic<bool> _stop;
+	std::vector<std::thread> _threads;
+
+};
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+//latency of every call in a run, and the period of the slow calls in it, engines that do their work in bursts (the
+//twist of a mersenne twister every 624 calls, the discards of ranlux) and distributions that compute two values and
+//hand out the cached one next (std normal) have a period the mean of a whole loop hides
+
+namespace trace {
+
+const int CALLS = 16384; //calls traced per row
+const int MAX_PERIOD = 1024; //longest period searched, fits 16 periods in a trace
+const double MIN_CORRELATION = 0.3; //weaker autocorrelation than this is noise, not a period
+const double SPIKE_FACTOR = 1.5; //a phase slower than this times the typical call is part of the spike
+
+struct Periodicity
+{
+	int period = 0; //calls, 0 if none was found
+	double correlation = 0; //autocorrelation of the latencies at period
+	double typical = 0; //ns of a call outside the spike, the lower quartile of the phase means
+	double spike = 0; //ns the slowest phase takes beyond typical
+	double fraction = 0; //of the traced time spent in spike phases, or without a period in calls over 3 times the median
+
+};
+
+//the p quantile of values, values is reordered
+inline double quantile(std::vector<double>& values, double p)
+{
+	std::size_t k = static_cast<std::size_t>(p * (values.size() - 1));
+	std::nth_element(values.begin(), values.begin() + k, values.end());
+	return values[k];
+}
+
+//autocorrelation of ns over lags 2 to MAX_PERIOD, the period is the shortest lag within 90% of the strongest, so a
+//multiple of the period does not win over the period itself, then the trace is folded by phase to size the spike
+inline Periodicity analyze(const std::vector<double>& ns)
+{
+	Periodicity result;
+	const int n = static_cast<int>(ns.size());
+	const int maxLag = std::min(MAX_PERIOD, n / 2);
+	double mean = 0;
+	for (double v : ns)
+		mean += v;
+	mean /= n;
+	std::vector<double> centered(ns.size());
+	double variance = 0;
+	for (int i = 0; i < n; i++)
+	{
+		centered[i] = ns[i] - mean;
+		variance += centered[i] * centered[i];
+	}
+	if (variance <= 0)
+		return result;
+	std::vector<double> correlation(maxLag + 1, 0.0);
+	double best = 0;
+	for (int lag = 2; lag <= maxLag; lag++)
+	{
+		double sum = 0;
+		for (int i = lag; i < n; i++)
+			sum += centered[i] * centered[i - lag];
+		correlation[lag] = sum / variance * n / (n - lag); //unbiased, so long lags are not penalised for having fewer pairs
+		best = std::max(best, correlation[lag]);
+	}
+	double total = 0;
+	for (double v : ns)
+		total += v;
+	if (best >= MIN_CORRELATION)
+	{
+		for (int lag = 2; lag <= maxLag; lag++)
+			if (correlation[lag] >= best * 0.9)
+			{
+				result.period = lag;
+				result.correlation = correlation[lag];
+				break;
+			}
+		std::vector<double> phase(result.period, 0.0);
+		const int folds = n / result.period;
+		for (int i = 0; i < folds * result.period; i++)
+			phase[i % result.period] += ns[i] / folds;
+		std::vector<double> sorted = phase;
+		result.typical = quantile(sorted, 0.25);
+		result.spike = *std::max_element(phase.begin(), phase.end()) - result.typical;
+		double spiking = 0;
+		for (int i = 0; i < folds * result.period; i++)
+			if (phase[i % result.period] > result.typical * SPIKE_FACTOR)
+				spiking += ns[i];
+		result.fraction = total > 0 ? spiking / total : 0;
+	}
+	else
+	{ //no period, the outliers are what is left to report
+		std::vector<double> sorted = ns;
+		result.typical = quantile(sorted, 0.5);
+		double spiking = 0;
+		double slowest = 0;
+		for (double v : ns)
+		{
+			slowest = std::max(slowest, v);
+			if (v > result.typical * 3)
+				spiking += v;
+		}
+		result.spike = slowest - result.typical;
+		result.fraction = total > 0 ? spiking / total : 0;
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+
+//what the operating system and the heap did during a test, sampled before and after it and subtracted
+//windows reports no context switches per process and counts soft and hard page faults together as minor faults
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+
+namespace usage {
+
+#ifdef _MSC_VER
+const bool SWITCHES = false; //context switch counts are available
+#else
+const bool SWITCHES = true;
+#endif
+
+struct Usage
+{
+	long long int minorFaults = 0;
+	long long int majorFaults = 0;
+	long long int voluntarySwitches = 0; //waits, e.g. for a page from disk
+	long long int involuntarySwitches = 0; //preemptions, anything else the scheduler ran meanwhile
+	long long int peakRss = 0; //bytes, a high water mark of the process, never a difference
+	long long int allocations = 0;
+	long long int allocatedBytes = 0;
+
+};
+
+//whether the global operator new counts, set by -v, constant initialised so it is false for allocations made before
+//any constructor of the program ran
+inline bool& counting()
+{
+	static bool on = false;
+	return on;
+}
+
+//counts of the global operator new, which counts every allocation of the program
+inline std::atomic<long long int>& allocations()
+{
+	static std::atomic<long long int> count(0);
+	return count;
+}
+
+inline std::atomic<long long int>& allocatedBytes()
+{
+	static std::atomic<long long int> bytes(0);
+	return bytes;
+}
+
+inline void countAllocation(std::size_t size)
+{
+	allocations().fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes().fetch_add(static_cast<long long int>(size), std::memory_order_relaxed);
+}
+
+//the counters of the process so far
+inline Usage sample()
+{
+	Usage u;
+#ifdef _MSC_VER
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters))
+	{
+		u.minorFaults = counters.PageFaultCount;
+		u.peakRss = counters.PeakWorkingSetSize;
+	}
+#else
+	rusage r;
+	if (getrusage(RUSAGE_SELF, &r) == 0)
+	{
+		u.minorFaults = r.ru_minflt;
+		u.majorFaults = r.ru_majflt;
+		u.voluntarySwitches = r.ru_nvcsw;
+		u.involuntarySwitches = r.ru_nivcsw;
+#ifdef __APPLE__
+		u.peakRss = r.ru_maxrss;
+#else
+		u.peakRss = r.ru_maxrss * 1024LL; //kilobytes
+#endif
+	}
+#endif
+	u.allocations = allocations().load(std::memory_order_relaxed);
+	u.allocatedBytes = allocatedBytes().load(std::memory_order_relaxed);
+	return u;
+}
+
+//what happened between before and after, peak RSS stays the high water mark at after
+inline Usage operator-(const Usage& after, const Usage& before)
+{
+	Usage u;
+	u.minorFaults = after.minorFaults - before.minorFaults;
+	u.majorFaults = after.majorFaults - before.majorFaults;
+	u.voluntarySwitches = after.voluntarySwitches - before.voluntarySwitches;
+	u.involuntarySwitches = after.involuntarySwitches - before.involuntarySwitches;
+	u.peakRss = after.peakRss;
+	u.allocations = after.allocations - before.allocations;
+	u.allocatedBytes = after.allocatedBytes - before.allocatedBytes;
+	return u;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const Usage& u)
+{
+	return out << u.minorFaults << ' ' << u.majorFaults << ' ' << u.voluntarySwitches << ' ' << u.involuntarySwitches << ' '
+		<< u.peakRss << ' ' << u.allocations << ' ' << u.allocatedBytes;
+}
+
+inline std::istream& operator>>(std::istream& in, Usage& u)
+{
+	return in >> u.minorFaults >> u.majorFaults >> u.voluntarySwitches >> u.involuntarySwitches
+		>> u.peakRss >> u.allocations >> u.allocatedBytes;
+}
+
+}
@@ -0,0 +1,457 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "distributions.h"
+#include "simd.h"
+
+//ziggurat samplers after Marsaglia and Tsang, laid out as in Doornik's ZIGNOR with 256 layers
+//a draw takes layer i and u from one random word and accepts x = u * x[i] when |u| < x[i + 1] / x[i], about 99% of draws
+//that fast path runs in SIMD lanes over a block of words, the misses are finished one by one through the wedge and tail tests
+
+namespace zig {
+
+const int LAYERS = 256;
+const int BLOCK = 256; //words per kernel call, the lanes of every ISA divide it
+
+
+//f(x) = exp(-x^2 / 2), u in [-1, 1) covers both sides
+struct NormalShape
+{
+	static const bool symmetric = true;
+	static double r() { return 3.6541528853610088; } //start of the tail
+	static double v() { return 0.00492867323399; } //area of each layer
+	static double f(double x) { return std::exp(-0.5 * x * x); }
+	static double inverse(double y) { return std::sqrt(-2.0 * std::log(y)); }
+
+	//x beyond r, Marsaglia's tail method
+	template<typename Engine>
+	static double tail(Engine& eng)
+	{
+		double x, y;
+		do
+		{
+			x = std::log(1.0 - FastRealDistribution<double>::canonical(eng)) / r();
+			y = std::log(1.0 - FastRealDistribution<double>::canonical(eng));
+		} while (-2.0 * y < x * x);
+		return r() - x;
+	}
+};
+
+//f(x) = exp(-x), u in [0, 1) covers the one side
+struct ExponentialShape
+{
+	static const bool symmetric = false;
+	static double r() { return 7.69711747013104972; }
+	static double v() { return 0.0039496598225815571993; }
+	static double f(double x) { return std::exp(-x); }
+	static double inverse(double y) { return -std::log(y); }
+
+	//the tail beyond r is itself exponential, shifted by r
+	template<typename Engine>
+	static double tail(Engine& eng)
+	{
+		return r() - std::log(1.0 - FastRealDistribution<double>::canonical(eng));
+	}
+};
+
+//f(x) = exp(-|x|), the exponential layers mirrored through the sign of u
+struct LaplaceShape : ExponentialShape
+{
+	static const bool symmetric = true;
+	static double f(double x) { return std::exp(-std::fabs(x)); }
+};
+
+
+//layer edges and the fast path tables in the precision of the kernel
+template<typename Shape, typename RealType>
+struct Table
+{
+	double x[LAYERS + 1]; //x[0] is the width the base layer would have if it carried its tail as a rectangle
+	double fx[LAYERS + 1]; //f(x[i])
+	RealType width[LAYERS]; //x[i]
+	RealType ratio[LAYERS]; //x[i + 1] / x[i], rounded toward zero so an accepted point never leaves its layer
+
+	Table()
+	{
+		x[0] = Shape::v() / Shape::f(Shape::r());
+		x[1] = Shape::r();
+		for (int i = 2; i < LAYERS; i++)
+			x[i] = Shape::inverse(Shape::v() / x[i - 1] + Shape::f(x[i - 1]));
+		x[LAYERS] = 0;
+		for (int i = 0; i <= LAYERS; i++)
+			fx[i] = Shape::f(x[i]);
+		for (int i = 0; i < LAYERS; i++)
+		{
+			width[i] = static_cast<RealType>(x[i]);
+			double exact = x[i + 1] / x[i];
+			RealType rounded = static_cast<RealType>(exact);
+			if (rounded > exact)
+				rounded = std::nextafter(rounded, RealType(0));
+			ratio[i] = rounded;
+		}
+	}
+
+	static const Table& get()
+	{
+		static const Table table;
+		return table;
+	}
+};
+
+
+//layer from the low 8 bits, u from the top mantissa bits as m in [1, 2), so no integer to float conversion is needed
+template<bool Symmetric>
+inline void decode(std::uint32_t word, int& i, float& u)
+{
+	i = word & 0xFF;
+	std::uint32_t bits = (word >> 9) | 0x3F800000;
+	float m;
+	std::memcpy(&m, &bits, sizeof(m));
+	u = Symmetric ? m + m - 3.0f : m - 1.0f;
+}
+
+template<bool Symmetric>
+inline void decode(std::uint64_t word, int& i, double& u)
+{
+	i = word & 0xFF;
+	std::uint64_t bits = (word >> 12) | 0x3FF0000000000000;
+	double m;
+	std::memcpy(&m, &bits, sizeof(m));
+	u = Symmetric ? m + m - 3.0 : m - 1.0;
+}
+
+
+//fast path kernels, out[j] = u * x[i] for every word and the index of each word that missed goes to missed
+//n is a multiple of 16, returns the number of misses
+template<bool Symmetric, typename Word, typename RealType>
+int fastScalar(const Word* words, RealType* out, int n, int* missed, const RealType* width, const RealType* ratio)
+{
+	int misses = 0;
+	for (int j = 0; j < n; j++)
+	{
+		int i;
+		RealType u;
+		decode<Symmetric>(words[j], i, u);
+		out[j] = u * width[i];
+		if (!(std::fabs(u) < ratio[i]))
+			missed[misses++] = j;
+	}
+	return misses;
+}
+
+#if SIMD_X86
+template<bool Symmetric>
+SIMD_TARGET("sse2") int fastFloatSse2(const std::uint32_t* words, float* out, int n, int* missed, const float* width, const float* ratio)
+{
+	const __m128i one = _mm_set1_epi32(0x3F800000);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	int misses = 0;
+	for (int j = 0; j < n; j += 4)
+	{
+		__m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + j));
+		__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(w, 9), one));
+		__m128 u = Symmetric ? _mm_sub_ps(_mm_add_ps(m, m), _mm_set1_ps(3.0f)) : _mm_sub_ps(m, _mm_set1_ps(1.0f));
+		//no gather before AVX2, the layers are looked up one at a time
+		__m128 wi = _mm_setr_ps(width[words[j] & 0xFF], width[words[j + 1] & 0xFF], width[words[j + 2] & 0xFF], width[words[j + 3] & 0xFF]);
+		__m128 ri = _mm_setr_ps(ratio[words[j] & 0xFF], ratio[words[j + 1] & 0xFF], ratio[words[j + 2] & 0xFF], ratio[words[j + 3] & 0xFF]);
+		_mm_storeu_ps(out + j, _mm_mul_ps(u, wi));
+		unsigned int miss = ~_mm_movemask_ps(_mm_cmplt_ps(_mm_and_ps(u, absMask), ri)) & 0xF;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+
+template<bool Symmetric>
+SIMD_TARGET("sse2") int fastDoubleSse2(const std::uint64_t* words, double* out, int n, int* missed, const double* width, const double* ratio)
+{
+	const __m128i one = _mm_set1_epi64x(0x3FF0000000000000);
+	const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+	int misses = 0;
+	for (int j = 0; j < n; j += 2)
+	{
+		__m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + j));
+		__m128d m = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(w, 12), one));
+		__m128d u = Symmetric ? _mm_sub_pd(_mm_add_pd(m, m), _mm_set1_pd(3.0)) : _mm_sub_pd(m, _mm_set1_pd(1.0));
+		__m128d wi = _mm_setr_pd(width[words[j] & 0xFF], width[words[j + 1] & 0xFF]);
+		__m128d ri = _mm_setr_pd(ratio[words[j] & 0xFF], ratio[words[j + 1] & 0xFF]);
+		_mm_storeu_pd(out + j, _mm_mul_pd(u, wi));
+		unsigned int miss = ~_mm_movemask_pd(_mm_cmplt_pd(_mm_and_pd(u, absMask), ri)) & 0x3;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+
+template<bool Symmetric>
+SIMD_TARGET("avx2") int fastFloatAvx2(const std::uint32_t* words, float* out, int n, int* missed, const float* width, const float* ratio)
+{
+	const __m256i one = _mm256_set1_epi32(0x3F800000);
+	const __m256i low = _mm256_set1_epi32(0xFF);
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	int misses = 0;
+	for (int j = 0; j < n; j += 8)
+	{
+		__m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + j));
+		__m256i layer = _mm256_and_si256(w, low);
+		__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(w, 9), one));
+		__m256 u = Symmetric ? _mm256_sub_ps(_mm256_add_ps(m, m), _mm256_set1_ps(3.0f)) : _mm256_sub_ps(m, _mm256_set1_ps(1.0f));
+		__m256 wi = _mm256_i32gather_ps(width, layer, 4);
+		__m256 ri = _mm256_i32gather_ps(ratio, layer, 4);
+		_mm256_storeu_ps(out + j, _mm256_mul_ps(u, wi));
+		unsigned int miss = ~_mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(u, absMask), ri, _CMP_LT_OQ)) & 0xFF;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+
+template<bool Symmetric>
+SIMD_TARGET("avx2") int fastDoubleAvx2(const std::uint64_t* words, double* out, int n, int* missed, const double* width, const double* ratio)
+{
+	const __m256i one = _mm256_set1_epi64x(0x3FF0000000000000);
+	const __m256i low = _mm256_set1_epi64x(0xFF);
+	const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+	int misses = 0;
+	for (int j = 0; j < n; j += 4)
+	{
+		__m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + j));
+		__m256i layer = _mm256_and_si256(w, low);
+		__m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(w, 12), one));
+		__m256d u = Symmetric ? _mm256_sub_pd(_mm256_add_pd(m, m), _mm256_set1_pd(3.0)) : _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+		__m256d wi = _mm256_i64gather_pd(width, layer, 8);
+		__m256d ri = _mm256_i64gather_pd(ratio, layer, 8);
+		_mm256_storeu_pd(out + j, _mm256_mul_pd(u, wi));
+		unsigned int miss = ~_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(u, absMask), ri, _CMP_LT_OQ)) & 0xF;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+
+#if SIMD_AVX512
+template<bool Symmetric>
+SIMD_TARGET("avx512f") int fastFloatAvx512(const std::uint32_t* words, float* out, int n, int* missed, const float* width, const float* ratio)
+{
+	const __m512i one = _mm512_set1_epi32(0x3F800000);
+	const __m512i low = _mm512_set1_epi32(0xFF);
+	const __m512i absMask = _mm512_set1_epi32(0x7FFFFFFF);
+	int misses = 0;
+	for (int j = 0; j < n; j += 16)
+	{
+		__m512i w = _mm512_loadu_si512(words + j);
+		__m512i layer = _mm512_and_si512(w, low);
+		__m512 m = _mm512_castsi512_ps(_mm512_or_si512(_mm512_srli_epi32(w, 9), one));
+		__m512 u = Symmetric ? _mm512_sub_ps(_mm512_add_ps(m, m), _mm512_set1_ps(3.0f)) : _mm512_sub_ps(m, _mm512_set1_ps(1.0f));
+		__m512 wi = _mm512_i32gather_ps(layer, width, 4);
+		__m512 ri = _mm512_i32gather_ps(layer, ratio, 4);
+		_mm512_storeu_ps(out + j, _mm512_mul_ps(u, wi));
+		__m512 au = _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(u), absMask));
+		unsigned int miss = ~static_cast<unsigned int>(_mm512_cmp_ps_mask(au, ri, _CMP_LT_OQ)) & 0xFFFF;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+
+template<bool Symmetric>
+SIMD_TARGET("avx512f") int fastDoubleAvx512(const std::uint64_t* words, double* out, int n, int* missed, const double* width, const double* ratio)
+{
+	const __m512i one = _mm512_set1_epi64(0x3FF0000000000000);
+	const __m512i low = _mm512_set1_epi64(0xFF);
+	const __m512i absMask = _mm512_set1_epi64(0x7FFFFFFFFFFFFFFF);
+	int misses = 0;
+	for (int j = 0; j < n; j += 8)
+	{
+		__m512i w = _mm512_loadu_si512(words + j);
+		__m512i layer = _mm512_and_si512(w, low);
+		__m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(w, 12), one));
+		__m512d u = Symmetric ? _mm512_sub_pd(_mm512_add_pd(m, m), _mm512_set1_pd(3.0)) : _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+		__m512d wi = _mm512_i64gather_pd(layer, width, 8);
+		__m512d ri = _mm512_i64gather_pd(layer, ratio, 8);
+		_mm512_storeu_pd(out + j, _mm512_mul_pd(u, wi));
+		__m512d au = _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(u), absMask));
+		unsigned int miss = ~static_cast<unsigned int>(_mm512_cmp_pd_mask(au, ri, _CMP_LT_OQ)) & 0xFF;
+		for (; miss; miss &= miss - 1)
+			missed[misses++] = j + simd::lowestBit(miss);
+	}
+	return misses;
+}
+#endif
+#endif
+
+
+template<typename RealType, bool Symmetric>
+struct Kernels;
+
+template<bool Symmetric>
+struct Kernels<float, Symmetric>
+{
+	typedef int(*Fast)(const std::uint32_t*, float*, int, int*, const float*, const float*);
+	static const simd::Dispatch<Fast>& get()
+	{
+#if SIMD_AVX512
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint32_t, float>, &fastFloatSse2<Symmetric>, nullptr, &fastFloatAvx2<Symmetric>, &fastFloatAvx512<Symmetric> } } };
+#elif SIMD_X86
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint32_t, float>, &fastFloatSse2<Symmetric>, nullptr, &fastFloatAvx2<Symmetric>, nullptr } } };
+#else
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint32_t, float>, nullptr, nullptr, nullptr, nullptr } } };
+#endif
+		return table;
+	}
+};
+
+template<bool Symmetric>
+struct Kernels<double, Symmetric>
+{
+	typedef int(*Fast)(const std::uint64_t*, double*, int, int*, const double*, const double*);
+	static const simd::Dispatch<Fast>& get()
+	{
+#if SIMD_AVX512
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint64_t, double>, &fastDoubleSse2<Symmetric>, nullptr, &fastDoubleAvx2<Symmetric>, &fastDoubleAvx512<Symmetric> } } };
+#elif SIMD_X86
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint64_t, double>, &fastDoubleSse2<Symmetric>, nullptr, &fastDoubleAvx2<Symmetric>, nullptr } } };
+#else
+		static const simd::Dispatch<Fast> table = { { { &fastScalar<Symmetric, std::uint64_t, double>, nullptr, nullptr, nullptr, nullptr } } };
+#endif
+		return table;
+	}
+};
+
+
+//block sampler, values are shift + scale * z for a standard variate z of Shape
+template<typename Shape, typename RealType>
+class ZigguratDistribution
+{
+public:
+	typedef RealType result_type;
+	typedef typename std::conditional<(sizeof(RealType) > 4), std::uint64_t, std::uint32_t>::type Word;
+	typedef Kernels<RealType, Shape::symmetric> KernelTable;
+
+	ZigguratDistribution(RealType shift, RealType scale, int isa)
+		: _shift(shift), _scale(scale), _table(&Table<Shape, RealType>::get()), _next(BLOCK)
+	{
+		selectIsa(isa);
+	}
+
+	//use the fast path kernel for isa, or the best one below it
+	void selectIsa(int isa) { _fast = KernelTable::get().select(isa); }
+
+	//drop any values left in the block
+	void reset() { _next = BLOCK; }
+
+	template<typename Engine>
+	result_type operator()(Engine& eng)
+	{
+		if (_next == BLOCK)
+			refill(eng);
+		return _shift + _scale * _block[_next++];
+	}
+
+	//write a variate to every element of [first, last), a block at a time
+	template<typename Iter, typename Engine>
+	void fill(Iter first, Iter last, Engine& eng)
+	{
+		while (first != last)
+		{
+			if (_next == BLOCK)
+				refill(eng);
+			for (; _next < BLOCK && first != last; ++_next, ++first)
+				*first = _shift + _scale * _block[_next];
+		}
+	}
+
+protected:
+	RealType _shift;
+	RealType _scale;
+
+private:
+	template<typename Engine>
+	void refill(Engine& eng)
+	{
+		for (int j = 0; j < BLOCK; j++)
+			_words[j] = uniformBits<Word>(eng);
+		int misses = _fast(_words, _block, BLOCK, _missed, _table->width, _table->ratio);
+		for (int m = 0; m < misses; m++)
+		{ //scalar fixup pass for the lanes that missed their rectangle
+			int i;
+			RealType u;
+			decode<Shape::symmetric>(_words[_missed[m]], i, u);
+			_block[_missed[m]] = finish(eng, i, u);
+		}
+		_next = 0;
+	}
+
+	//complete a draw that missed the fast path, redrawing from scratch after a wedge rejection
+	template<typename Engine>
+	RealType finish(Engine& eng, int i, RealType u)
+	{
+		for (;;)
+		{
+			if (i == 0)
+			{
+				double t = Shape::tail(eng);
+				return static_cast<RealType>(Shape::symmetric && u < 0 ? -t : t);
+			}
+			double x = u * _table->x[i];
+			//a uniform height inside layer i, accepted when it lies under the curve
+			double y = _table->fx[i] + FastRealDistribution<double>::canonical(eng) * (_table->fx[i + 1] - _table->fx[i]);
+			if (y < Shape::f(x))
+				return static_cast<RealType>(x);
+			decode<Shape::symmetric>(uniformBits<Word>(eng), i, u);
+			if (std::fabs(u) < _table->ratio[i])
+				return u * _table->width[i];
+		}
+	}
+
+	const Table<Shape, RealType>* _table;
+	typename KernelTable::Fast _fast;
+	int _next;
+	Word _words[BLOCK];
+	RealType _block[BLOCK];
+	int _missed[BLOCK];
+
+};
+
+}
+
+
+//normal distribution on the SIMD ziggurat, batch with fill(first, last, eng) or per value through a block buffer
+template<typename RealType = float>
+class ZigguratNormalDistribution : public zig::ZigguratDistribution<zig::NormalShape, RealType>
+{
+public:
+	explicit ZigguratNormalDistribution(RealType mean = 0, RealType stddev = 1, int isa = simd::detectIsa())
+		: zig::ZigguratDistribution<zig::NormalShape, RealType>(mean, stddev, isa) {}
+
+	RealType mean() const { return this->_shift; }
+	RealType stddev() const { return this->_scale; }
+
+};
+
+//exponential distribution on the SIMD ziggurat, the tail needs no rejection loop
+template<typename RealType = float>
+class ZigguratExponentialDistribution : public zig::ZigguratDistribution<zig::ExponentialShape, RealType>
+{
+public:
+	explicit ZigguratExponentialDistribution(RealType lambda = 1, int isa = simd::detectIsa())
+		: zig::ZigguratDistribution<zig::ExponentialShape, RealType>(0, 1 / lambda, isa) {}
+
+	RealType lambda() const { return 1 / this->_scale; }
+
+};
+
+//laplace distribution on the exponential layers with the sign taken from u
+template<typename RealType = float>
+class ZigguratLaplaceDistribution : public zig::ZigguratDistribution<zig::LaplaceShape, RealType>
+{
+public:
+	explicit ZigguratLaplaceDistribution(RealType mean = 0, RealType beta = 1, int isa = simd::detectIsa())
+		: zig::ZigguratDistribution<zig::LaplaceShape, RealType>(mean, beta, isa) {}
+
+	RealType mean() const { return this->_shift; }
+	RealType beta() const { return this->_scale; }
+
+};